@@ -11,13 +11,112 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #ifndef SYNCBUS_BUFFER_SIZE
 #define SYNCBUS_BUFFER_SIZE 64U
 #endif
 
+// Frame buffer of WideFrame instances (default: UDP payload on a
+// 1500-byte Ethernet MTU)
+#ifndef SYNCBUS_WIDE_BUFFER_SIZE
+#define SYNCBUS_WIDE_BUFFER_SIZE 1472U
+#endif
+
 #ifndef SYNCBUS_ENABLE_SET_ACK
-#define SyncBus_ENABLE_SET_ACK 1
+#define SYNCBUS_ENABLE_SET_ACK 1
+#endif
+
+// CRC16 engines: bit-by-bit loop (no table, smallest flash), 2x16-entry
+// nibble table (64 bytes), 256-entry byte table (512 bytes) or slicing-by-8/16
+// (4/8 KiB, 8 or 16 bytes per iteration, for hosts with large frames)
+#define SYNCBUS_CRC_BITWISE 0
+#define SYNCBUS_CRC_NIBBLE 1
+#define SYNCBUS_CRC_TABLE 2
+#define SYNCBUS_CRC_SLICE8 3
+#define SYNCBUS_CRC_SLICE16 4
+
+#ifndef SYNCBUS_CRC_MODE
+#define SYNCBUS_CRC_MODE SYNCBUS_CRC_TABLE
+#endif
+
+// Bulk (fragmented) transfers: fragments sent per window before the
+// receiver acknowledges or requests the next window
+#ifndef SYNCBUS_BULK_WINDOW
+#define SYNCBUS_BULK_WINDOW 4U
+#endif
+
+// Request pipelining: tagged requests a client keeps outstanding
+// (0 = off: stop-and-wait, untagged frames)
+#ifndef SYNCBUS_MAX_PENDING
+#define SYNCBUS_MAX_PENDING 0U
+#endif
+
+// Server slotId lookup: 256-entry direct table (O(1), 256 bytes per server)
+// or sorted index with binary search (numSlots bytes, for small RAM)
+#define SYNCBUS_SLOT_INDEX_DIRECT 0
+#define SYNCBUS_SLOT_INDEX_SORTED 1
+
+#ifndef SYNCBUS_SLOT_INDEX
+#define SYNCBUS_SLOT_INDEX SYNCBUS_SLOT_INDEX_DIRECT
+#endif
+
+// Carry-less multiply folding kernel for long frames: PCLMULQDQ on x86-64
+// (runtime dispatch) or PMULL on AArch64 (when built with the AES/crypto
+// extension). Frames below Crc16ClmulMin bytes and other targets use the
+// SYNCBUS_CRC_MODE engine.
+#ifndef SYNCBUS_ENABLE_CRC_CLMUL
+#define SYNCBUS_ENABLE_CRC_CLMUL 0
+#endif
+
+// The AArch64 PMULL kernel has not been validated on hardware yet; it is
+// only built when explicitly requested (run tests/crc_equivalence_test.cpp
+// on the target first)
+#ifndef SYNCBUS_ENABLE_CRC_PMULL
+#define SYNCBUS_ENABLE_CRC_PMULL 0
+#endif
+
+#if SYNCBUS_ENABLE_CRC_CLMUL && defined(__x86_64__) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define SYNCBUS_CRC_CLMUL_X86 1
+#include <immintrin.h>
+#elif SYNCBUS_ENABLE_CRC_CLMUL && SYNCBUS_ENABLE_CRC_PMULL \
+    && defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define SYNCBUS_CRC_CLMUL_ARM 1
+#include <arm_neon.h>
+#endif
+
+// C++20 coroutine awaitables for client GET/SET (co_await client.get(...));
+// on by default when the compiler implements coroutines
+#ifndef SYNCBUS_ENABLE_COROUTINES
+#if defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L) \
+    && __has_include(<coroutine>)
+#define SYNCBUS_ENABLE_COROUTINES 1
+#else
+#define SYNCBUS_ENABLE_COROUTINES 0
+#endif
+#endif
+
+#if SYNCBUS_ENABLE_COROUTINES
+#include <coroutine>
+#endif
+
+// Lock-free TX frame pool (SyncBusFramePool) for asynchronous transports;
+// needs a lock-free 32-bit compare-and-swap
+#ifndef SYNCBUS_ENABLE_FRAME_POOL
+#define SYNCBUS_ENABLE_FRAME_POOL 0
+#endif
+
+// Concurrent server slots: per-slot seqlock, publish()/snapshot() from
+// application threads while a bus thread serves the slots
+#ifndef SYNCBUS_ENABLE_SEQLOCK
+#define SYNCBUS_ENABLE_SEQLOCK 0
+#endif
+
+#if SYNCBUS_ENABLE_FRAME_POOL || SYNCBUS_ENABLE_SEQLOCK
+#include <atomic>
 #endif
 
 namespace SyncBus
@@ -35,6 +134,8 @@ static constexpr uint8_t FrameFunction = 5U;
 static constexpr uint8_t FrameData = 6U;
 static constexpr uint8_t HeaderSize = 6U; // 4 + 1 + 1
 
+static constexpr uint8_t NoSlot = 0xFFU; // "not registered" slot index
+
 // ---- Function codes --------------------------------------------------------
 enum class SyncBusFunc : uint8_t
 {
@@ -42,35 +143,85 @@ enum class SyncBusFunc : uint8_t
   SetReq = 1U,
   GetResp = 2U,
   SetResp = 3U,
+  GetMultiReq = 4U,   // Data: slotId list; FrameSlotId: count
+  GetMultiResp = 5U,  // Data: records; FrameSlotId: record count
+  SetMultiReq = 6U,   // Data: records; FrameSlotId: record count
+  SetMultiResp = 7U,  // Data: status bitmap (bit r = record r applied)
+  Subscribe = 8U,     // Data: optional period (uint16_t LE, ticks; 0 = on change)
+  Unsubscribe = 9U,
+  GetIfModReq = 10U,  // Data: client's version (uint16_t LE) or empty
+  GetVerResp = 11U,   // Data: version (uint16_t LE) + slot data
+  NotModified = 12U,  // Data: version (uint16_t LE)
+  GetDeltaReq = 13U,  // Data: client's reference version (uint16_t LE) or empty
+  DeltaResp = 14U,    // Data: base version, new version, patches
+  SetDeltaReq = 15U,  // Data: flags, base version, patches (or full data)
+  SetDeltaResp = 16U, // Data: status (1 = applied), server version
+  BulkGetReq = 17U,   // Data: offset (uint16_t LE), window (fragment count)
+  BulkGetResp = 18U,  // Data: fragment header + bytes
+  BulkSetReq = 19U,   // Data: fragment header + bytes
+  BulkSetResp = 20U,  // Data: bytes received in order (uint16_t LE)
 };
 
+static constexpr uint8_t VersionSize = 2U;
+
+// Transaction ID: a function byte with FuncFlagTid set is followed by a TID
+// byte and the data starts one byte later. Servers echo the TID in their
+// reply, so a client can pipeline requests and match the responses.
+static constexpr uint8_t FuncFlagTid = 0x80U;
+static constexpr uint8_t TidSize = 1U;
+static constexpr uint16_t NoTid = 0x100U;  // untagged frame
+
+// Delta patch: [offset][run][run bytes]
+static constexpr uint8_t PatchHeaderSize = 2U;
+static constexpr uint8_t DeltaFlagFull = 0x01U;  // SetDeltaReq carries full data
+
+// Bulk fragment header: [offset (2)][total (2)][flags]
+static constexpr uint8_t FragHeaderSize = 5U;
+static constexpr uint8_t FragFlagWindowEnd = 0x01U;  // ack / next window due
+static constexpr uint8_t FragPayloadMax = static_cast<uint8_t>(
+    SYNCBUS_BUFFER_SIZE - HeaderSize - FragHeaderSize - 2U);
+static_assert(SYNCBUS_BUFFER_SIZE > (HeaderSize + FragHeaderSize + 2U),
+              "SYNCBUS_BUFFER_SIZE too small for bulk fragments");
+
+// Multi-slot record: [slotId][len][data (len bytes)]
+static constexpr uint8_t RecordHeaderSize = 2U;
+
 enum class result
 {
   ok,
   errOverflow,
   errCrc,
   errFault,
+  errDuplicate,
+  errBusy,      // pending request table full
+  errTimeout,   // request unanswered after its last retry
 };
 
 // ---- Callback types --------------------------------------------------------
 using SyncBusSendData_cb = void (*)(const uint8_t* data, uint8_t size);
 using SyncBusDataChanged_cb = void (*)(uint8_t slotId);
+using SyncBusSendDataWide_cb = void (*)(const uint8_t* data, uint16_t size);
+using SyncBusDataChangedWide_cb = void (*)(uint16_t slotId);
+// Outcome of a pending request: ok, errTimeout or errFault (malformed
+// response); 'slot' is the client's slot index
+using SyncBusRequestDone_cb = void (*)(uint32_t serverId, uint8_t slot,
+    result status);
 
-// ---- Slot records ----------------------------------------------------------
-struct serverData_t
+// Gather list entry for the vectored send callbacks, mirrors POSIX iovec
+struct SyncBusIoVec
 {
-  void *data;     // pointer to application buffer
-  uint32_t serverId;
-  uint8_t slotId;
-  uint8_t size;    // number of bytes in 'data'
+  const void *base;
+  size_t len;
 };
-
-struct clientSlot_t
+// Vectored send: the frame is the concatenation of 'count' entries
+using SyncBusSendVec_cb = void (*)(const SyncBusIoVec *iov, uint8_t count);
+// First constructor argument selecting the vectored send callbacks, so a
+// plain callback or nullptr never resolves to them
+struct SyncBusVectored_t
 {
-  void *data;    // pointer to application buffer
-  uint8_t slotId;
-  uint8_t size;
+  explicit SyncBusVectored_t() = default;
 };
+static constexpr SyncBusVectored_t SyncBusVectored { };
 
 // ---- Endianness helpers (LE) -----------------------------------------------
 static inline void write_le32(uint8_t *dst, uint32_t v) noexcept
@@ -81,6 +232,17 @@ static inline void write_le32(uint8_t *dst, uint32_t v) noexcept
   dst[3] = static_cast<uint8_t>((v >> 24) & 0xFFU);
 }
 
+static inline void write_le16(uint8_t *dst, uint16_t v) noexcept
+{
+  dst[0] = static_cast<uint8_t>(v & 0xFFU);
+  dst[1] = static_cast<uint8_t>((v >> 8) & 0xFFU);
+}
+
+static inline uint16_t read_le16(const uint8_t *src) noexcept
+{
+  return static_cast<uint16_t>(src[0] | (src[1] << 8));
+}
+
 static inline uint32_t read_le32(const uint8_t *src) noexcept
 {
   return (static_cast<uint32_t>(src[0])) | (static_cast<uint32_t>(src[1]) << 8)
@@ -88,379 +250,4139 @@ static inline uint32_t read_le32(const uint8_t *src) noexcept
       | (static_cast<uint32_t>(src[3]) << 24);
 }
 
-// ---- CRC16 (Modbus poly 0xA001), LO then HI appended -----------------------
-static inline uint8_t genCRC16(uint8_t *buff, uint8_t len) noexcept
+// ---- Frame formats ---------------------------------------------------------
+// Selected by the Format parameter of SyncBusClient/SyncBusServer.
+// CompactFrame (default, MCUs): the layout above, 8-bit slotIds and
+// lengths, frames up to 255 bytes.
+// WideFrame (Ethernet, shared memory): 16-bit slotIds and lengths, frames
+// up to SYNCBUS_WIDE_BUFFER_SIZE bytes:
+// [0..3] ServerId (LE)  [4..5] SlotId (LE)  [6] Function  [7..] Data  CRC16
+// Multi-slot record and delta patch fields widen to 16 bits as well.
+struct CompactFrame
 {
-  uint16_t crc = 0xFFFFU;
+  using length_t = uint8_t;  // frame, payload and slot lengths
+  using slot_t = uint8_t;
+  using send_cb = SyncBusSendData_cb;
+  using changed_cb = SyncBusDataChanged_cb;
+
+  static constexpr uint8_t FrameSlotId = SyncBus::FrameSlotId;
+  static constexpr uint8_t FrameFunction = SyncBus::FrameFunction;
+  static constexpr uint8_t FrameData = SyncBus::FrameData;
+  static constexpr uint8_t HeaderSize = SyncBus::HeaderSize;
+  static constexpr uint8_t RecordHeaderSize = SyncBus::RecordHeaderSize;
+  static constexpr uint8_t PatchHeaderSize = SyncBus::PatchHeaderSize;
+  static constexpr size_t BufferSize = SYNCBUS_BUFFER_SIZE;
+  static constexpr length_t FragPayloadMax = SyncBus::FragPayloadMax;
 
-  for (uint8_t pos = 0U; pos < len; ++pos)
+  // slotId / length field
+  static void writeField(uint8_t *dst, length_t v) noexcept
   {
-    crc ^= static_cast<uint16_t>(buff[pos]);
-    for (uint8_t i = 0U; i < 8U; ++i)
-    {
-      const bool lsb = (crc & 0x0001U) != 0U;
-      crc >>= 1;
-      if (lsb)
-      {
-        crc ^= 0xA001U;
-      }
-    }
+    dst[0] = v;
   }
 
-  const uint8_t lo = static_cast<uint8_t>(crc & 0xFFU);
-  const uint8_t hi = static_cast<uint8_t>((crc >> 8) & 0xFFU);
-
-  buff[len++] = lo;
-  buff[len++] = hi;
-  return len;
-}
+  static length_t readField(const uint8_t *src) noexcept
+  {
+    return src[0];
+  }
+};
 
-static inline bool checkCRC16(const uint8_t *buff, uint8_t len) noexcept
+struct WideFrame
 {
-  if (len < 2U)
+  using length_t = uint16_t;
+  using slot_t = uint16_t;
+  using send_cb = SyncBusSendDataWide_cb;
+  using changed_cb = SyncBusDataChangedWide_cb;
+
+  static constexpr uint8_t FrameSlotId = 4U;
+  static constexpr uint8_t FrameFunction = 6U;
+  static constexpr uint8_t FrameData = 7U;
+  static constexpr uint8_t HeaderSize = 7U; // 4 + 2 + 1
+  static constexpr uint8_t RecordHeaderSize = 4U;
+  static constexpr uint8_t PatchHeaderSize = 4U;
+  static constexpr size_t BufferSize = SYNCBUS_WIDE_BUFFER_SIZE;
+  static constexpr length_t FragPayloadMax = static_cast<length_t>(
+      BufferSize - HeaderSize - FragHeaderSize - 2U);
+
+  static void writeField(uint8_t *dst, length_t v) noexcept
   {
-    return false;
+    write_le16(dst, v);
   }
 
-  uint16_t crc = 0xFFFFU;
-  const uint8_t body = static_cast<uint8_t>(len - 2U);
-
-  for (uint8_t pos = 0U; pos < body; ++pos)
+  static length_t readField(const uint8_t *src) noexcept
   {
-    crc ^= static_cast<uint16_t>(buff[pos]);
-    for (uint8_t i = 0U; i < 8U; ++i)
-    {
-      const bool lsb = (crc & 0x0001U) != 0U;
-      crc >>= 1;
-      if (lsb)
-      {
-        crc ^= 0xA001U;
-      }
-    }
+    return read_le16(src);
   }
+};
 
-  const uint8_t lo = static_cast<uint8_t>(crc & 0xFFU);
-  const uint8_t hi = static_cast<uint8_t>((crc >> 8) & 0xFFU);
-  return (buff[len - 2U] == lo) && (buff[len - 1U] == hi);
-}
+static_assert((SYNCBUS_WIDE_BUFFER_SIZE > (WideFrame::HeaderSize
+              + FragHeaderSize + 2U)) && (SYNCBUS_WIDE_BUFFER_SIZE <= 0xFFFFU),
+              "SYNCBUS_WIDE_BUFFER_SIZE out of range");
 
-// ============================================================================
-//                                CLIENT
-// ============================================================================
-template<uint8_t numSlots>
-class SyncBusClient
+// ---- Hooks -----------------------------------------------------------------
+// Hooks policy (last template parameter of SyncBusClient/SyncBusServer): how
+// an instance sends frames and reports events. A custom policy is a class,
+// stored in the instance, providing
+//   void send(const uint8_t *data, length_t size) noexcept;
+//   void changed(uint32_t serverId, slot_t slotId, uint8_t slot) noexcept;
+//   void done(uint32_t serverId, uint8_t slot, result status) noexcept;
+// ('done' for clients only); its calls inline into the protocol code.
+// 'slot' is the instance's slot index (bulk index for bulk slots).
+// A policy may also provide
+//   bool gather() const noexcept;
+//   void sendv(const SyncBusIoVec *iov, uint8_t count) noexcept;
+// While gather() is true, frames carrying slot data go to sendv as
+// header / payload / CRC entries, the payload pointing into the application
+// slot (valid only during the call), instead of being copied into the
+// frame buffer: writev/sendmsg or DMA descriptor chains send them as is.
+// CallbackHooks, the default, calls runtime function pointers: the plain
+// callback types, or ones receiving a context pointer, so many instances
+// can share code without globals. Given a vectored send callback, every
+// frame goes through it (staged frames as a single entry).
+template<typename Format>
+class CallbackHooks
 {
 public:
-  explicit SyncBusClient(SyncBusSendData_cb SendData_cb,
-      SyncBusDataChanged_cb DataChanged_cb = nullptr) noexcept :
-      m_numSlots(0U), m_sendData_cb(SendData_cb), m_dataChanged_cb(
-          DataChanged_cb)
+  using length_t = typename Format::length_t;
+  using slot_t = typename Format::slot_t;
+  using sendCtx_cb = void (*)(void *ctx, const uint8_t *data, length_t size);
+  using changedCtx_cb = void (*)(void *ctx, uint32_t serverId, slot_t slotId,
+      uint8_t slot);
+  using doneCtx_cb = void (*)(void *ctx, uint32_t serverId, uint8_t slot,
+      result status);
+  using sendVecCtx_cb = void (*)(void *ctx, const SyncBusIoVec *iov,
+      uint8_t count);
+
+  CallbackHooks(typename Format::send_cb SendData_cb = nullptr,
+      typename Format::changed_cb DataChanged_cb = nullptr,
+      SyncBusRequestDone_cb RequestDone_cb = nullptr) noexcept :
+      m_sendData_cb(SendData_cb), m_dataChanged_cb(DataChanged_cb), m_requestDone_cb(
+          RequestDone_cb), m_sendVec_cb(nullptr), m_ctx(nullptr), m_sendCtx_cb(
+          nullptr), m_changedCtx_cb(nullptr), m_doneCtx_cb(nullptr), m_sendVecCtx_cb(
+          nullptr)
   {
-    // no-op
   }
 
-  // GET request for a managed slot
-  result getData(uint32_t serverId, uint8_t slot) noexcept
+  CallbackHooks(void *ctx, sendCtx_cb SendData_cb,
+      changedCtx_cb DataChanged_cb = nullptr,
+      doneCtx_cb RequestDone_cb = nullptr) noexcept :
+      m_sendData_cb(nullptr), m_dataChanged_cb(nullptr), m_requestDone_cb(
+          nullptr), m_sendVec_cb(nullptr), m_ctx(ctx), m_sendCtx_cb(SendData_cb), m_changedCtx_cb(
+          DataChanged_cb), m_doneCtx_cb(RequestDone_cb), m_sendVecCtx_cb(nullptr)
   {
-    if (slot >= m_numSlots)
-    {
-      return result::errOverflow;
-    }
+  }
 
-    if (m_serveSlots[slot].data == nullptr)
-    {
-      return result::errFault;
-    }
+  // Vectored send callbacks
+  CallbackHooks(SyncBusVectored_t, SyncBusSendVec_cb SendVec_cb,
+      typename Format::changed_cb DataChanged_cb = nullptr,
+      SyncBusRequestDone_cb RequestDone_cb = nullptr) noexcept :
+      m_sendData_cb(nullptr), m_dataChanged_cb(DataChanged_cb), m_requestDone_cb(
+          RequestDone_cb), m_sendVec_cb(SendVec_cb), m_ctx(nullptr), m_sendCtx_cb(
+          nullptr), m_changedCtx_cb(nullptr), m_doneCtx_cb(nullptr), m_sendVecCtx_cb(
+          nullptr)
+  {
+  }
 
-    // total = header + crc
-    if ((static_cast<uint16_t>(HeaderSize) + 2U) > SYNCBUS_BUFFER_SIZE)
-    {
-      return result::errOverflow;
-    }
+  CallbackHooks(SyncBusVectored_t, void *ctx, sendVecCtx_cb SendVec_cb,
+      changedCtx_cb DataChanged_cb = nullptr,
+      doneCtx_cb RequestDone_cb = nullptr) noexcept :
+      m_sendData_cb(nullptr), m_dataChanged_cb(nullptr), m_requestDone_cb(
+          nullptr), m_sendVec_cb(nullptr), m_ctx(ctx), m_sendCtx_cb(nullptr), m_changedCtx_cb(
+          DataChanged_cb), m_doneCtx_cb(RequestDone_cb), m_sendVecCtx_cb(SendVec_cb)
+  {
+  }
 
-    write_le32(&m_buffer[FrameServerId], serverId);
-    m_buffer[FrameSlotId] = m_serveSlots[slot].slotId;
-    m_buffer[FrameFunction] = static_cast<uint8_t>(SyncBusFunc::GetReq);
+  bool gather() const noexcept
+  {
+    return (m_sendVecCtx_cb != nullptr) || (m_sendVec_cb != nullptr);
+  }
 
-    uint8_t size = genCRC16(m_buffer, HeaderSize);
-    if (m_sendData_cb != nullptr)
+  void sendv(const SyncBusIoVec *iov, uint8_t count) const noexcept
+  {
+    if (m_sendVecCtx_cb != nullptr)
+    {
+      m_sendVecCtx_cb(m_ctx, iov, count);
+    } else if (m_sendVec_cb != nullptr)
     {
-      m_sendData_cb(m_buffer, size);
+      m_sendVec_cb(iov, count);
     }
-    return result::ok;
   }
 
-  // SET request for a managed slot (sends current local data of that slot)
-  result setData(uint32_t serverId, uint8_t slot) noexcept
+  void send(const uint8_t *data, length_t size) const noexcept
   {
-    if (slot >= m_numSlots)
+    if (gather())
     {
-      return result::errOverflow;
-    }
-    if (m_serveSlots[slot].data == nullptr)
+      const SyncBusIoVec iov = { data, size };
+      sendv(&iov, 1U);
+    } else if (m_sendCtx_cb != nullptr)
     {
-      return result::errFault;
-    }
-
-    const uint8_t payload = m_serveSlots[slot].size;
-    const uint16_t totalNoCrc = static_cast<uint16_t>(HeaderSize)
-        + static_cast<uint16_t>(payload);
-
-    if (totalNoCrc + 2U > SYNCBUS_BUFFER_SIZE)
+      m_sendCtx_cb(m_ctx, data, size);
+    } else if (m_sendData_cb != nullptr)
     {
-      return result::errOverflow;
+      m_sendData_cb(data, size);
     }
+  }
 
-    write_le32(&m_buffer[FrameServerId], serverId);
-    m_buffer[FrameSlotId] = m_serveSlots[slot].slotId;
-    m_buffer[FrameFunction] = static_cast<uint8_t>(SyncBusFunc::SetReq);
-
-    std::memcpy(&m_buffer[FrameData], m_serveSlots[slot].data, payload);
-
-    uint8_t size = genCRC16(m_buffer, static_cast<uint8_t>(totalNoCrc));
-    if (m_sendData_cb != nullptr)
+  void changed(uint32_t serverId, slot_t slotId, uint8_t slot) const noexcept
+  {
+    if (m_changedCtx_cb != nullptr)
     {
-      m_sendData_cb(m_buffer, size);
+      m_changedCtx_cb(m_ctx, serverId, slotId, slot);
+    } else if (m_dataChanged_cb != nullptr)
+    {
+      m_dataChanged_cb(slotId);
     }
-    return result::ok;
   }
 
-  // Incoming data (GetResp / SetResp)
-  result inputData(const uint8_t *data, uint8_t size) noexcept
+  void done(uint32_t serverId, uint8_t slot, result status) const noexcept
   {
-    if (size < static_cast<uint8_t>(HeaderSize + 2U))
+    if (m_doneCtx_cb != nullptr)
     {
-      return result::errFault;
-    }
-    if (!checkCRC16(data, size))
+      m_doneCtx_cb(m_ctx, serverId, slot, status);
+    } else if (m_requestDone_cb != nullptr)
     {
-      return result::errCrc;
+      m_requestDone_cb(serverId, slot, status);
     }
+  }
 
-    const uint32_t serverId = read_le32(&data[FrameServerId]);
-    const auto function = static_cast<SyncBusFunc>(data[FrameFunction]);
-    const uint8_t slotId = data[FrameSlotId];
+private:
+  typename Format::send_cb m_sendData_cb;
+  typename Format::changed_cb m_dataChanged_cb;
+  SyncBusRequestDone_cb m_requestDone_cb;
+  SyncBusSendVec_cb m_sendVec_cb;
+  void *m_ctx;
+  sendCtx_cb m_sendCtx_cb;
+  changedCtx_cb m_changedCtx_cb;
+  doneCtx_cb m_doneCtx_cb;
+  sendVecCtx_cb m_sendVecCtx_cb;
+};
 
-    const uint8_t payloadLen = static_cast<uint8_t>(size - HeaderSize - 2U);
+// Policies without gather() always get staged frames
+template<typename Hooks, typename = void>
+struct hooksGather_t : std::false_type
+{
+};
 
-    if (function == SyncBusFunc::GetResp)
-    {
-      for (uint8_t i = 0U; i < m_numSlots; ++i)
-      {
-        if ((m_serveSlots[i].serverId == serverId)
-            && (m_serveSlots[i].slotId == slotId))
-        {
+template<typename Hooks>
+struct hooksGather_t<Hooks,
+    decltype(static_cast<void>(std::declval<const Hooks&>().gather()))> :
+    std::true_type
+{
+};
 
-          if (payloadLen != m_serveSlots[i].size)
-          {
-            return result::errFault;
-          }
-          std::memcpy(m_serveSlots[i].data, &data[FrameData], payloadLen);
 
-          if (m_dataChanged_cb != nullptr)
-          {
-            m_dataChanged_cb(slotId);
-          }
-          break;
-        }
-      }
-    } else if (function == SyncBusFunc::SetResp)
-    {
-      // Optional: handle ACK, e.g., notify or update a status map
-      // Currently no state kept → treated as success notification.
-    }
+// ---- Slot records ----------------------------------------------------------
+template<typename Format>
+struct serverData_t
+{
+  void *data;     // pointer to application buffer
+  uint32_t serverId;
+  typename Format::slot_t slotId;
+  typename Format::length_t size;    // number of bytes in 'data'
+  uint16_t version;     // server version of 'data', if versionValid
+  bool versionValid;
+  void *reference;      // delta reference copy (nullptr = delta disabled)
+  uint16_t refVersion;  // server version 'reference' holds, if refValid
+  bool refValid;
+};
 
-    return result::ok;
-  }
+template<typename Format>
+struct clientSlot_t
+{
+  void *data;    // pointer to application buffer
+  typename Format::slot_t slotId;
+  typename Format::length_t size;
+  uint8_t subscribers;   // Subscribe minus Unsubscribe requests seen
+  uint16_t period;       // periodic publish interval (ticks), 0 = on change
+  uint32_t lastPublish;  // tick of the last periodic publish
+  uint16_t hash;         // CRC16 of 'data' at the last detectChanges()
+  uint16_t version;      // bumped on every change of 'data'
+  void *reference;       // delta reference copy (nullptr = delta disabled)
+  uint16_t refVersion;   // version 'reference' holds, if refValid
+  bool refValid;
+};
 
-  // Register a (serverId, slotId, size, data*)
-  result addData(void *data, uint32_t serverId, uint8_t slotId,
-      uint8_t size) noexcept
-  {
-    if (data == nullptr)
-    {
-      return result::errFault;
-    }
-    if (m_numSlots >= numSlots)
-    {
-      return result::errOverflow;
-    }
+// Bulk slots: up to 64 KiB, moved in FragPayloadMax-byte fragments.
+// 'staging' (optional, same size) receives the fragments so 'data' only
+// changes once a transfer is complete.
+template<typename Format>
+struct bulkData_t
+{
+  void *data;
+  void *staging;
+  uint32_t serverId;
+  typename Format::slot_t slotId;
+  uint16_t size;
+  uint16_t next;   // bytes received (GET) or acknowledged (SET) in order
+  uint8_t state;   // BulkIdle / BulkGetting / BulkSetting
+};
 
-    // enforce maximum payload per frame
-    if ((static_cast<uint16_t>(HeaderSize) + size + 2U) > SYNCBUS_BUFFER_SIZE)
-    {
-      return result::errOverflow;
-    }
+template<typename Format>
+struct bulkSlot_t
+{
+  void *data;
+  void *staging;
+  typename Format::slot_t slotId;
+  uint16_t size;
+  uint16_t next;   // bytes of the incoming SET received in order
+};
 
-    m_serveSlots[m_numSlots].data = data;
-    m_serveSlots[m_numSlots].serverId = serverId;
-    m_serveSlots[m_numSlots].slotId = slotId;
-    m_serveSlots[m_numSlots].size = size;
-    ++m_numSlots;
+// Outstanding tagged request of a client
+struct pending_t
+{
+  uint32_t serverId;
+  uint32_t sentAt;   // tick of the last transmission
+  uint16_t timeout;  // ticks to wait for the response (doubles per retry)
+  uint8_t slot;      // local slot index
+  uint8_t tid;
+  uint8_t function;  // request (SyncBusFunc), for retransmission
+  uint8_t retries;   // retransmissions so far
+  bool used;
+  void *waiter;      // awaiting coroutine (SyncBusClient::Awaiter), or nullptr
+};
 
-    return result::ok;
+static constexpr uint8_t BulkIdle = 0U;
+static constexpr uint8_t BulkGetting = 1U;
+static constexpr uint8_t BulkSetting = 2U;
+
+// Bulk records and pending requests are private bases, so a zero count
+// takes no RAM (empty base). The zero case indexes one shared record that
+// is never reached: the counts bounding every index stay 0.
+template<typename T>
+struct noRecords_t
+{
+  T& operator[](size_t) const noexcept
+  {
+    return none;
   }
 
-private:
-  uint8_t m_numSlots;
-  serverData_t m_serveSlots[numSlots];
-  SyncBusSendData_cb m_sendData_cb;
-  SyncBusDataChanged_cb m_dataChanged_cb;
-  uint8_t m_buffer[SYNCBUS_BUFFER_SIZE];
+  static inline T none { };
 };
 
-// ============================================================================
-//                                SERVER
-// ============================================================================
-template<uint8_t numSlots>
-class SyncBusServer
+template<typename T, uint8_t N>
+struct bulkStore_t
 {
-public:
-  explicit SyncBusServer(uint32_t id) noexcept :
-      m_serverId(id), m_numSlots(0U), m_sendData_cb(nullptr), m_dataChanged_cb(
-          nullptr)
+  T m_bulk[N];
+};
+
+template<typename T>
+struct bulkStore_t<T, 0U>
+{
+  static constexpr noRecords_t<T> m_bulk { };
+};
+
+template<uint8_t N>
+struct pendingStore_t
+{
+  pending_t m_pending[N];
+};
+
+template<>
+struct pendingStore_t<0U>
+{
+  static constexpr noRecords_t<pending_t> m_pending { };
+};
+
+// ---- Typed slot handles ----------------------------------------------------
+// Returned by the typed addData/addSlot overloads; carries the slot type so
+// the encode path copies sizeof(T) as a compile-time constant.
+template<typename T, typename Format = CompactFrame>
+struct TypedSlot
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SyncBus: slot type must be trivially copyable");
+  static_assert((Format::HeaderSize + sizeof(T) + 2U) <= Format::BufferSize,
+                "SyncBus: slot frame exceeds the frame buffer");
+
+  uint8_t index;  // slot index in the owning client/server, NoSlot if invalid
+
+  bool valid() const noexcept
   {
+    return index != NoSlot;
   }
+};
 
-  SyncBusServer(uint32_t id, SyncBusSendData_cb SendData_cb,
-      SyncBusDataChanged_cb DataChanged_cb = nullptr) noexcept :
-      m_serverId(id), m_numSlots(0U), m_sendData_cb(SendData_cb), m_dataChanged_cb(
-          DataChanged_cb)
+// ---- Slot copy -------------------------------------------------------------
+// Scalar-sized slots get a constant-size memcpy (a single load/store)
+static inline void copySlot(void *dst, const void *src, size_t size) noexcept
+{
+  switch (size)
   {
+  case 1U:
+    std::memcpy(dst, src, 1U);
+    break;
+  case 2U:
+    std::memcpy(dst, src, 2U);
+    break;
+  case 4U:
+    std::memcpy(dst, src, 4U);
+    break;
+  case 8U:
+    std::memcpy(dst, src, 8U);
+    break;
+  default:
+    std::memcpy(dst, src, size);
+    break;
   }
+}
 
-  void setId(uint32_t serverId) noexcept
+// ---- Bit scan --------------------------------------------------------------
+// Index of the lowest set bit of a non-zero word
+static inline uint8_t lowestBit(uint32_t v) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint8_t>(__builtin_ctz(v));
+#else
+  uint8_t n = 0U;
+  while ((v & 1U) == 0U)
   {
-    m_serverId = serverId;
+    v >>= 1;
+    ++n;
   }
+  return n;
+#endif
+}
 
-  // Incoming data (GetReq / SetReq)
-  result inputData(const uint8_t *data, uint8_t size) noexcept
+// ---- CRC16 (Modbus poly 0xA001), LO then HI appended -----------------------
+static constexpr uint16_t Crc16Init = 0xFFFFU;
+static constexpr uint16_t Crc16Poly = 0xA001U;
+
+// Reflected shift of 'crc' by 'bits' positions (the classic bit-by-bit loop)
+static constexpr uint16_t crc16Shift(uint16_t crc, uint8_t bits) noexcept
+{
+  for (uint8_t i = 0U; i < bits; ++i)
   {
-    if (size < static_cast<uint8_t>(HeaderSize + 2U))
+    const bool lsb = (crc & 0x0001U) != 0U;
+    crc >>= 1;
+    if (lsb)
     {
-      return result::errFault;
+      crc ^= Crc16Poly;
     }
-    if (!checkCRC16(data, size))
+  }
+  return crc;
+}
+
+// Lookup tables, generated at compile time. T[n] is the CRC of byte 'n'
+// starting from zero; 'lo'/'hi' split it per nibble (T[n] = lo[n&15]^hi[n>>4]).
+struct crc16Table_t
+{
+  uint16_t lut[256];
+  constexpr crc16Table_t() noexcept :
+      lut { }
+  {
+    for (uint16_t n = 0U; n < 256U; ++n)
     {
-      return result::errCrc;
+      lut[n] = crc16Shift(n, 8U);
     }
+  }
+};
 
-    const uint32_t serverId = read_le32(&data[FrameServerId]);
-    if (serverId != m_serverId)
+struct crc16NibbleTable_t
+{
+  uint16_t lo[16];
+  uint16_t hi[16];
+  constexpr crc16NibbleTable_t() noexcept :
+      lo { }, hi { }
+  {
+    for (uint16_t n = 0U; n < 16U; ++n)
     {
-      // Not for this server; ignore silently or return a benign code.
-      return result::ok;
+      lo[n] = crc16Shift(n, 8U);
+      hi[n] = crc16Shift(static_cast<uint16_t>(n << 4), 8U);
     }
+  }
+};
+
+// Slicing tables: lut[k][n] is the CRC of byte 'n' followed by k zero bytes
+template<uint8_t slices>
+struct crc16SliceTable_t
+{
+  uint16_t lut[slices][256];
+  constexpr crc16SliceTable_t() noexcept :
+      lut { }
+  {
+    for (uint16_t n = 0U; n < 256U; ++n)
+    {
+      lut[0][n] = crc16Shift(n, 8U);
+    }
+    for (uint8_t k = 1U; k < slices; ++k)
+    {
+      for (uint16_t n = 0U; n < 256U; ++n)
+      {
+        const uint16_t prev = lut[k - 1U][n];
+        lut[k][n] = static_cast<uint16_t>((prev >> 8)
+            ^ lut[0][prev & 0xFFU]);
+      }
+    }
+  }
+};
+
+#if SYNCBUS_CRC_MODE == SYNCBUS_CRC_TABLE
+inline constexpr crc16Table_t Crc16Lut { };
+#elif SYNCBUS_CRC_MODE == SYNCBUS_CRC_NIBBLE
+inline constexpr crc16NibbleTable_t Crc16NibbleLut { };
+#elif SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE8
+static constexpr uint8_t Crc16Slices = 8U;
+inline constexpr crc16SliceTable_t<Crc16Slices> Crc16SliceLut { };
+#elif SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE16
+static constexpr uint8_t Crc16Slices = 16U;
+inline constexpr crc16SliceTable_t<Crc16Slices> Crc16SliceLut { };
+#elif SYNCBUS_CRC_MODE != SYNCBUS_CRC_BITWISE
+#error "SyncBus: unknown SYNCBUS_CRC_MODE"
+#endif
+
+// Feed one byte into a running CRC (byte engine of SYNCBUS_CRC_MODE)
+static constexpr uint16_t crc16Step(uint16_t crc, uint8_t byte) noexcept
+{
+#if SYNCBUS_CRC_MODE == SYNCBUS_CRC_TABLE
+  return static_cast<uint16_t>((crc >> 8) ^ Crc16Lut.lut[(crc ^ byte) & 0xFFU]);
+#elif (SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE8) \
+    || (SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE16)
+  return static_cast<uint16_t>((crc >> 8)
+      ^ Crc16SliceLut.lut[0][(crc ^ byte) & 0xFFU]);
+#elif SYNCBUS_CRC_MODE == SYNCBUS_CRC_NIBBLE
+  const uint8_t idx = static_cast<uint8_t>((crc ^ byte) & 0xFFU);
+  return static_cast<uint16_t>((crc >> 8) ^ Crc16NibbleLut.lo[idx & 0x0FU]
+      ^ Crc16NibbleLut.hi[idx >> 4]);
+#else
+  return crc16Shift(static_cast<uint16_t>(crc ^ byte), 8U);
+#endif
+}
+
+// Feed 'len' bytes into a running CRC (engine selected by SYNCBUS_CRC_MODE)
+static constexpr uint16_t crc16Portable(uint16_t crc, const uint8_t *buff,
+    size_t len) noexcept
+{
+#if (SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE8) \
+    || (SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE16)
+  // The running CRC is absorbed by the first two bytes of each block; every
+  // byte then contributes its table entry for the distance to the block end.
+  while (len >= Crc16Slices)
+  {
+    crc ^= static_cast<uint16_t>(buff[0] | (buff[1] << 8));
+    uint16_t next = static_cast<uint16_t>(
+        Crc16SliceLut.lut[Crc16Slices - 1U][crc & 0xFFU]
+            ^ Crc16SliceLut.lut[Crc16Slices - 2U][crc >> 8]);
+    for (uint8_t k = 2U; k < Crc16Slices; ++k)
+    {
+      next ^= Crc16SliceLut.lut[Crc16Slices - 1U - k][buff[k]];
+    }
+    crc = next;
+    buff += Crc16Slices;
+    len -= Crc16Slices;
+  }
+#endif
+
+  for (size_t pos = 0U; pos < len; ++pos)
+  {
+    crc = crc16Step(crc, buff[pos]);
+  }
+  return crc;
+}
+
+// Compile-time equivalence check of the selected engine against the bitwise
+// loop, for every length/alignment up to three 16-byte blocks.
+static constexpr bool crc16SelfTest() noexcept
+{
+  uint8_t data[48] = { };
+  for (uint8_t i = 0U; i < sizeof(data); ++i)
+  {
+    data[i] = static_cast<uint8_t>((i * 37U) ^ 0x5AU);
+  }
+  for (uint8_t off = 0U; off < 16U; ++off)
+  {
+    uint16_t ref = Crc16Init;
+    for (uint8_t len = 0U; (off + len) <= sizeof(data); ++len)
+    {
+      if (crc16Portable(Crc16Init, &data[off], len) != ref)
+      {
+        return false;
+      }
+      if ((off + len) < sizeof(data))
+      {
+        ref = crc16Shift(static_cast<uint16_t>(ref ^ data[off + len]), 8U);
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(crc16SelfTest(), "SyncBus: CRC16 engine mismatch");
+
+#if defined(SYNCBUS_CRC_CLMUL_X86) || defined(SYNCBUS_CRC_CLMUL_ARM)
+static constexpr size_t Crc16ClmulMin = 32U;
+
+// x^n mod P (P = x^16 + x^15 + x^2 + 1), bit-reflected into a 64-bit lane
+static constexpr uint64_t crc16FoldConst(uint16_t n) noexcept
+{
+  uint32_t rem = 1U;
+  for (uint16_t i = 0U; i < n; ++i)
+  {
+    rem <<= 1;
+    if ((rem & 0x10000U) != 0U)
+    {
+      rem ^= 0x18005U;
+    }
+  }
+  uint64_t k = 0U;
+  for (uint8_t d = 0U; d < 16U; ++d)
+  {
+    if ((rem & (1U << d)) != 0U)
+    {
+      k |= 1ULL << (63U - d);
+    }
+  }
+  return k;
+}
+
+// A 16-byte block B = L*x^64 + H is folded over the next block as
+// L*(x^192 mod P) + H*(x^128 mod P); the carry-less product of two reflected
+// lanes carries an extra factor x, hence the x^191 / x^127 constants. The
+// remaining 16-byte accumulator and tail go through the table engine.
+static constexpr uint64_t Crc16FoldLo = crc16FoldConst(191U);
+static constexpr uint64_t Crc16FoldHi = crc16FoldConst(127U);
+
+#if defined(SYNCBUS_CRC_CLMUL_X86)
+__attribute__((target("pclmul,sse2")))
+static inline uint16_t crc16Clmul(uint16_t crc, const uint8_t *buff,
+    size_t len) noexcept
+{
+  const __m128i k = _mm_set_epi64x(static_cast<long long>(Crc16FoldHi),
+                                   static_cast<long long>(Crc16FoldLo));
+  // Running CRC enters as the first two message bytes (init 0 afterwards)
+  __m128i acc = _mm_xor_si128(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(buff)),
+      _mm_cvtsi32_si128(crc));
+  buff += 16U;
+  len -= 16U;
+
+  while (len >= 16U)
+  {
+    const __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    const __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    acc = _mm_xor_si128(_mm_xor_si128(lo, hi),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(buff)));
+    buff += 16U;
+    len -= 16U;
+  }
+
+  uint8_t rem[16];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(rem), acc);
+  return crc16Portable(crc16Portable(0U, rem, sizeof(rem)), buff, len);
+}
+
+static inline bool crc16ClmulAvailable() noexcept
+{
+  static const bool available = __builtin_cpu_supports("pclmul");
+  return available;
+}
+#else
+static inline uint16_t crc16Clmul(uint16_t crc, const uint8_t *buff,
+    size_t len) noexcept
+{
+  const poly64_t kLo = static_cast<poly64_t>(Crc16FoldLo);
+  const poly64_t kHi = static_cast<poly64_t>(Crc16FoldHi);
+  // Running CRC enters as the first two message bytes (init 0 afterwards)
+  uint64x2_t acc = veorq_u64(vreinterpretq_u64_u8(vld1q_u8(buff)),
+      vcombine_u64(vcreate_u64(crc), vcreate_u64(0U)));
+  buff += 16U;
+  len -= 16U;
+
+  while (len >= 16U)
+  {
+    const uint64x2_t lo = vreinterpretq_u64_p128(
+        vmull_p64(static_cast<poly64_t>(vgetq_lane_u64(acc, 0)), kLo));
+    const uint64x2_t hi = vreinterpretq_u64_p128(
+        vmull_p64(static_cast<poly64_t>(vgetq_lane_u64(acc, 1)), kHi));
+    acc = veorq_u64(veorq_u64(lo, hi), vreinterpretq_u64_u8(vld1q_u8(buff)));
+    buff += 16U;
+    len -= 16U;
+  }
+
+  uint8_t rem[16];
+  vst1q_u8(rem, vreinterpretq_u8_u64(acc));
+  return crc16Portable(crc16Portable(0U, rem, sizeof(rem)), buff, len);
+}
+
+static inline bool crc16ClmulAvailable() noexcept
+{
+  return true;
+}
+#endif
+#endif
+
+// Runtime CRC entry point: folding kernel for long buffers when the CPU has
+// it, otherwise the SYNCBUS_CRC_MODE engine
+static inline uint16_t crc16Update(uint16_t crc, const uint8_t *buff,
+    size_t len) noexcept
+{
+#if defined(SYNCBUS_CRC_CLMUL_X86) || defined(SYNCBUS_CRC_CLMUL_ARM)
+  if ((len >= Crc16ClmulMin) && crc16ClmulAvailable())
+  {
+    return crc16Clmul(crc, buff, len);
+  }
+#endif
+  return crc16Portable(crc, buff, len);
+}
+
+// Copy 'len' bytes to 'dst' and feed them into a running CRC in one pass
+static inline uint16_t crc16Copy(uint16_t crc, uint8_t *dst, const void *src,
+    size_t len) noexcept
+{
+  const uint8_t *in = static_cast<const uint8_t*>(src);
+
+#if defined(SYNCBUS_CRC_CLMUL_X86) || defined(SYNCBUS_CRC_CLMUL_ARM)
+  if ((len >= Crc16ClmulMin) && crc16ClmulAvailable())
+  {
+    std::memcpy(dst, in, len);
+    return crc16Clmul(crc, dst, len);
+  }
+#endif
+#if (SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE8) \
+    || (SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE16)
+  while (len >= Crc16Slices)
+  {
+    std::memcpy(dst, in, Crc16Slices);
+    crc = crc16Portable(crc, dst, Crc16Slices);
+    dst += Crc16Slices;
+    in += Crc16Slices;
+    len -= Crc16Slices;
+  }
+#endif
+
+  for (size_t pos = 0U; pos < len; ++pos)
+  {
+    const uint8_t byte = in[pos];
+    dst[pos] = byte;
+    crc = crc16Step(crc, byte);
+  }
+  return crc;
+}
+
+// Append 'crc' (LO then HI) at buff[len], returns the new length
+template<typename Len>
+static inline Len putCRC16(uint8_t *buff, Len len, uint16_t crc) noexcept
+{
+  const uint8_t lo = static_cast<uint8_t>(crc & 0xFFU);
+  const uint8_t hi = static_cast<uint8_t>((crc >> 8) & 0xFFU);
+
+  buff[len++] = lo;
+  buff[len++] = hi;
+  return len;
+}
+
+template<typename Len>
+static inline Len genCRC16(uint8_t *buff, Len len) noexcept
+{
+  return putCRC16(buff, len, crc16Update(Crc16Init, buff, len));
+}
+
+static inline bool checkCRC16(const uint8_t *buff, size_t len) noexcept
+{
+  if (len < 2U)
+  {
+    return false;
+  }
+
+  const size_t body = len - 2U;
+  const uint16_t crc = crc16Update(Crc16Init, buff, body);
+
+  const uint8_t lo = static_cast<uint8_t>(crc & 0xFFU);
+  const uint8_t hi = static_cast<uint8_t>((crc >> 8) & 0xFFU);
+  return (buff[len - 2U] == lo) && (buff[len - 1U] == hi);
+}
+
+// ---- Streaming CRC ---------------------------------------------------------
+// Running Modbus CRC over data arriving in pieces (header and payload from
+// separate buffers, or bytes as they come off a UART/socket).
+class Crc16State
+{
+public:
+  constexpr Crc16State() noexcept :
+      m_crc(Crc16Init)
+  {
+  }
+
+  void reset() noexcept
+  {
+    m_crc = Crc16Init;
+  }
+
+  void update(uint8_t byte) noexcept
+  {
+    m_crc = crc16Step(m_crc, byte);
+  }
+
+  void update(const void *data, size_t len) noexcept
+  {
+    m_crc = crc16Update(m_crc, static_cast<const uint8_t*>(data), len);
+  }
+
+  // Copy to 'dst' while checksumming (see crc16Copy)
+  void copy(uint8_t *dst, const void *src, size_t len) noexcept
+  {
+    m_crc = crc16Copy(m_crc, dst, src, len);
+  }
+
+  // CRC of everything fed so far (append LO then HI)
+  uint16_t finalize() const noexcept
+  {
+    return m_crc;
+  }
+
+  // True after a whole frame including its CRC trailer has been fed:
+  // the Modbus CRC of data + CRC(LO, HI) is zero.
+  bool valid() const noexcept
+  {
+    return m_crc == 0U;
+  }
+
+private:
+  uint16_t m_crc;
+};
+
+// ---- Frame builder ---------------------------------------------------------
+template<typename Format = CompactFrame>
+static inline uint8_t writeHeader(uint8_t *buff, uint32_t serverId,
+    typename Format::slot_t slotId, SyncBusFunc function,
+    uint16_t tid = NoTid) noexcept
+{
+  write_le32(&buff[FrameServerId], serverId);
+  Format::writeField(&buff[Format::FrameSlotId], slotId);
+  buff[Format::FrameFunction] = static_cast<uint8_t>(function);
+  if (tid == NoTid)
+  {
+    return Format::HeaderSize;
+  }
+  buff[Format::FrameFunction] = static_cast<uint8_t>(
+      buff[Format::FrameFunction] | FuncFlagTid);
+  buff[Format::HeaderSize] = static_cast<uint8_t>(tid);
+  return Format::HeaderSize + TidSize;
+}
+
+// 'len' bytes of 'data' after the 'head' bytes in 'buff', then the CRC; the
+// payload is copied and checksummed in one pass. Returns the frame length.
+template<typename Len>
+static inline Len appendPayload(uint8_t *buff, Len head, const void *data,
+    Len len) noexcept
+{
+  Crc16State crc;
+  crc.update(buff, head);
+  crc.copy(&buff[head], data, len);
+  return putCRC16(buff, static_cast<Len>(head + len), crc.finalize());
+}
+
+// Header + payload + CRC.
+// Caller guarantees HeaderSize (+ TidSize if tagged) + payloadLen + 2 <=
+// Format::BufferSize.
+template<typename Format = CompactFrame>
+static inline typename Format::length_t buildFrame(uint8_t *buff,
+    uint32_t serverId, typename Format::slot_t slotId, SyncBusFunc function,
+    const void *payload, typename Format::length_t payloadLen,
+    uint16_t tid = NoTid) noexcept
+{
+  using length_t = typename Format::length_t;
+  const length_t len = writeHeader<Format>(buff, serverId, slotId, function,
+                                           tid);
+  return appendPayload(buff, len, payload, payloadLen);
+}
+
+// Header + fragment header, returns its length
+template<typename Format = CompactFrame>
+static inline typename Format::length_t writeFragmentHeader(uint8_t *buff,
+    uint32_t serverId, typename Format::slot_t slotId, SyncBusFunc func,
+    uint16_t total, uint16_t offset, uint8_t flags) noexcept
+{
+  const uint8_t pos = writeHeader<Format>(buff, serverId, slotId, func);
+  write_le16(&buff[pos], offset);
+  write_le16(&buff[pos + 2U], total);
+  buff[pos + 4U] = flags;
+  return static_cast<typename Format::length_t>(pos + FragHeaderSize);
+}
+
+// Bulk fragment frame: header, fragment header, 'len' bytes of 'src' at
+// 'offset', CRC
+template<typename Format = CompactFrame>
+static inline typename Format::length_t buildFragment(uint8_t *buff,
+    uint32_t serverId, typename Format::slot_t slotId, SyncBusFunc func,
+    const void *src, uint16_t total, uint16_t offset,
+    typename Format::length_t len, uint8_t flags) noexcept
+{
+  using length_t = typename Format::length_t;
+  const length_t pos = writeFragmentHeader<Format>(buff, serverId, slotId,
+                                                   func, total, offset, flags);
+  std::memcpy(&buff[pos], static_cast<const uint8_t*>(src) + offset, len);
+  return genCRC16(buff, static_cast<length_t>(pos + len));
+}
+
+// Frame whose payload stays in application memory: 'head' bytes (header,
+// TID, version or fragment header) already in 'buff', then 'len' bytes of
+// 'data'. Gathering hooks get header / payload / CRC entries (the CRC
+// written at buff[head]); otherwise the payload is appended and the frame
+// sent staged.
+template<typename Hooks, typename Len>
+static inline void sendFrame(Hooks &hooks, uint8_t *buff, Len head,
+    const void *data, Len len) noexcept
+{
+  if constexpr (hooksGather_t<Hooks>::value)
+  {
+    if (hooks.gather())
+    {
+      Crc16State crc;
+      crc.update(buff, head);
+      crc.update(data, len);
+      putCRC16(buff, head, crc.finalize());
+      const SyncBusIoVec iov[3] = { { buff, head }, { data, len },
+                                    { &buff[head], 2U } };
+      hooks.sendv(iov, 3U);
+      return;
+    }
+  }
+  hooks.send(buff, appendPayload(buff, head, data, len));
+}
+
+// ---- Delta encoding --------------------------------------------------------
+// Patches turning 'ref' into 'cur'; offset and run are Format fields.
+// Equal gaps shorter than a patch header are folded into the surrounding
+// run. Returns false when the encoding would reach 'limit' bytes (the caller
+// then sends the full value).
+template<typename Format = CompactFrame>
+static inline bool encodeDelta(uint8_t *out, typename Format::length_t &outLen,
+    const uint8_t *ref, const uint8_t *cur, typename Format::length_t size,
+    typename Format::length_t limit) noexcept
+{
+  using length_t = typename Format::length_t;
+  constexpr uint8_t Field = Format::PatchHeaderSize / 2U;
+  uint32_t len = 0U;
+  length_t i = 0U;
+
+  while (i < size)
+  {
+    if (ref[i] == cur[i])
+    {
+      ++i;
+      continue;
+    }
+
+    const length_t start = i;
+    length_t end = static_cast<length_t>(i + 1U);
+    for (length_t j = end; (j < size) && ((j - end) <= Format::PatchHeaderSize);
+        ++j)
+    {
+      if (ref[j] != cur[j])
+      {
+        end = static_cast<length_t>(j + 1U);
+      }
+    }
+
+    const length_t run = static_cast<length_t>(end - start);
+    if ((len + Format::PatchHeaderSize + run) >= limit)
+    {
+      return false;
+    }
+    Format::writeField(&out[len], start);
+    Format::writeField(&out[len + Field], run);
+    len += Format::PatchHeaderSize;
+    std::memcpy(&out[len], &cur[start], run);
+    len += run;
+    i = end;
+  }
+
+  outLen = static_cast<length_t>(len);
+  return true;
+}
+
+// Apply patches to 'dst' ('size' bytes); nothing is written unless every
+// patch is well formed and in bounds
+template<typename Format = CompactFrame>
+static inline bool applyDelta(uint8_t *dst, typename Format::length_t size,
+    const uint8_t *patches, typename Format::length_t len) noexcept
+{
+  constexpr uint8_t Field = Format::PatchHeaderSize / 2U;
+  uint32_t off = 0U;
+  while (off < len)
+  {
+    if ((off + Format::PatchHeaderSize) > len)
+    {
+      return false;
+    }
+    const uint32_t at = Format::readField(&patches[off]);
+    const uint32_t run = Format::readField(&patches[off + Field]);
+    if (((at + run) > size) || ((off + Format::PatchHeaderSize + run) > len))
+    {
+      return false;
+    }
+    off += Format::PatchHeaderSize + run;
+  }
+
+  off = 0U;
+  while (off < len)
+  {
+    const uint32_t run = Format::readField(&patches[off + Field]);
+    std::memcpy(&dst[Format::readField(&patches[off])],
+                &patches[off + Format::PatchHeaderSize], run);
+    off += Format::PatchHeaderSize + run;
+  }
+  return true;
+}
+
+#if SYNCBUS_ENABLE_FRAME_POOL
+// ---- Frame pool ------------------------------------------------------------
+// Fixed set of caller-provided TX frames for transports that send after the
+// callback returns (DMA UART, io_uring): an instance given a pool with
+// setFramePool() encodes each frame into a pooled one, hands it to the send
+// callback and takes a fresh one; the transport owns the frame until it
+// calls release(data), from any thread or interrupt. Free frames form a
+// Treiber stack whose head carries a tag bumped on every update, so a
+// frame popped and pushed back between another thread's load and CAS
+// (ABA) cannot corrupt the list. The tag is 48 bits where 64-bit CAS is
+// lock-free, 16 bits otherwise (MCUs: an ISR cannot wrap it mid-CAS).
+template<typename Format = CompactFrame>
+struct SyncBusFrame
+{
+  uint8_t data[Format::BufferSize];
+  std::atomic<uint16_t> next;  // free list link (index), owned by the pool
+};
+
+template<typename Format = CompactFrame>
+class SyncBusFramePool
+{
+  // head word: tag above bit 16, index of the top free frame below
+  using head_t = std::conditional_t<std::atomic<uint64_t>::is_always_lock_free,
+      uint64_t, uint32_t>;
+
+public:
+  static constexpr uint16_t NoFrame = 0xFFFFU;
+
+  SyncBusFramePool(SyncBusFrame<Format> *frames, uint16_t count) noexcept :
+      m_frames(frames), m_count((frames != nullptr) ? count : 0U), m_head(
+          NoFrame)
+  {
+    if (m_count == NoFrame)
+    {
+      --m_count;
+    }
+    for (uint16_t i = 0U; i < m_count; ++i)
+    {
+      m_frames[i].next.store(static_cast<uint16_t>(((i + 1U) < m_count) ?
+          (i + 1U) : NoFrame), std::memory_order_relaxed);
+    }
+    m_head.store((m_count > 0U) ? 0U : NoFrame, std::memory_order_release);
+  }
+
+  // A free frame (BufferSize bytes), or nullptr when all are in flight
+  uint8_t* acquire() noexcept
+  {
+    head_t head = m_head.load(std::memory_order_acquire);
+    while ((head & 0xFFFFU) != NoFrame)
+    {
+      const uint16_t i = static_cast<uint16_t>(head & 0xFFFFU);
+      const uint16_t next = m_frames[i].next.load(std::memory_order_relaxed);
+      if (m_head.compare_exchange_weak(head, pack(next, head),
+                                       std::memory_order_acquire,
+                                       std::memory_order_acquire))
+      {
+        return m_frames[i].data;
+      }
+    }
+    return nullptr;
+  }
+
+  // Return a frame obtained from acquire(); other pointers are ignored
+  void release(const uint8_t *data) noexcept
+  {
+    const uint16_t i = indexOf(data);
+    if (i == NoFrame)
+    {
+      return;
+    }
+    head_t head = m_head.load(std::memory_order_relaxed);
+    do
+    {
+      m_frames[i].next.store(static_cast<uint16_t>(head & 0xFFFFU),
+                             std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(head, pack(i, head),
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+  }
+
+  bool owns(const uint8_t *data) const noexcept
+  {
+    return indexOf(data) != NoFrame;
+  }
+
+  // Free frames; a snapshot while other threads acquire/release
+  uint16_t available() const noexcept
+  {
+    uint16_t count = 0U;
+    uint16_t i = static_cast<uint16_t>(m_head.load(std::memory_order_acquire)
+        & 0xFFFFU);
+    while ((i != NoFrame) && (count < m_count))
+    {
+      ++count;
+      i = m_frames[i].next.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+private:
+  // 'index' under the next tag of 'head'
+  static head_t pack(uint16_t index, head_t head) noexcept
+  {
+    return static_cast<head_t>(((head >> 16) + 1U) << 16) | index;
+  }
+
+  // O(1): 'data' is the first member of its frame
+  uint16_t indexOf(const uint8_t *data) const noexcept
+  {
+    const uintptr_t offset = reinterpret_cast<uintptr_t>(data)
+        - reinterpret_cast<uintptr_t>(m_frames);
+    const uintptr_t i = offset / sizeof(SyncBusFrame<Format>);
+    if (((offset % sizeof(SyncBusFrame<Format>)) != 0U) || (i >= m_count))
+    {
+      return NoFrame;
+    }
+    return static_cast<uint16_t>(i);
+  }
+
+  SyncBusFrame<Format> *m_frames;
+  uint16_t m_count;
+  std::atomic<head_t> m_head;
+};
+#endif
+
+// ---- TX path ---------------------------------------------------------------
+// Hooks and frame buffer of a client/server. Without a frame pool m_buffer
+// is the instance's own frame; with one it points at a pooled frame (or
+// m_frame while none is free), so the instance is then non-copyable.
+template<typename Format, typename Hooks>
+class frameTx_t
+{
+public:
+#if SYNCBUS_ENABLE_FRAME_POOL
+  // Encode frames into 'pool' frames (see SyncBusFramePool): the send
+  // callback owns each frame it receives until pool.release(data). Requests
+  // return errBusy while all are in flight. nullptr restores the internal
+  // buffer, which the callback must consume before returning.
+  void setFramePool(SyncBusFramePool<Format> *pool) noexcept
+  {
+    if ((m_pool != nullptr) && (m_buffer != m_frame))
+    {
+      m_pool->release(m_buffer);
+    }
+    m_pool = pool;
+    m_buffer = m_frame;
+    txReady();
+  }
+#endif
+
+protected:
+  using length_t = typename Format::length_t;
+
+  explicit frameTx_t(const Hooks &hooks) noexcept :
+      m_hooks(hooks)
+  {
+#if SYNCBUS_ENABLE_FRAME_POOL
+    m_pool = nullptr;
+    m_buffer = m_frame;
+#endif
+  }
+
+#if SYNCBUS_ENABLE_FRAME_POOL
+  // m_buffer may point into the instance
+  frameTx_t(const frameTx_t&) = delete;
+  frameTx_t& operator=(const frameTx_t&) = delete;
+#endif
+
+  // With a frame pool the encoded frame goes to the transport and the
+  // next one is taken; a frame built while every pooled frame was in
+  // flight is dropped, like one lost on the link, unless one came back.
+  void transmit(length_t size) noexcept
+  {
+#if SYNCBUS_ENABLE_FRAME_POOL
+    if (m_pool != nullptr)
+    {
+      uint8_t *frame = m_buffer;
+      if (frame == m_frame)
+      {
+        frame = m_pool->acquire();
+        if (frame == nullptr)
+        {
+          return;
+        }
+        std::memcpy(frame, m_frame, size);
+      }
+      uint8_t *next = m_pool->acquire();
+      m_buffer = (next != nullptr) ? next : m_frame;
+      m_hooks.send(frame, size);
+      return;
+    }
+#endif
+    m_hooks.send(m_buffer, size);
+  }
+
+  // 'head' bytes in m_buffer followed by application data (see sendFrame);
+  // pooled frames outlive the call, so they are always staged
+  void transmit(length_t head, const void *data, length_t len) noexcept
+  {
+#if SYNCBUS_ENABLE_FRAME_POOL
+    if (m_pool != nullptr)
+    {
+      transmit(appendPayload(m_buffer, head, data, len));
+      return;
+    }
+#endif
+    sendFrame(m_hooks, m_buffer, head, data, len);
+  }
+
+  // Before encoding a request: false while a pool is set and all its frames
+  // are in flight
+  bool txReady() noexcept
+  {
+#if SYNCBUS_ENABLE_FRAME_POOL
+    if ((m_pool != nullptr) && (m_buffer == m_frame))
+    {
+      uint8_t *frame = m_pool->acquire();
+      if (frame == nullptr)
+      {
+        return false;
+      }
+      m_buffer = frame;
+    }
+#endif
+    return true;
+  }
+
+  Hooks m_hooks;
+#if SYNCBUS_ENABLE_FRAME_POOL
+  SyncBusFramePool<Format> *m_pool;  // TX frames (setFramePool), or nullptr
+  uint8_t *m_buffer;  // frame being encoded: m_frame or a pooled frame
+  uint8_t m_frame[Format::BufferSize];
+#else
+  uint8_t m_buffer[Format::BufferSize];
+#endif
+};
+
+// ============================================================================
+//                                CLIENT
+// ============================================================================
+template<uint8_t numSlots, uint8_t numBulk = 0U,
+    typename Format = CompactFrame, typename Hooks = CallbackHooks<Format>>
+class SyncBusClient: private frameTx_t<Format, Hooks>,
+    private bulkStore_t<bulkData_t<Format>, numBulk>,
+    private pendingStore_t<SYNCBUS_MAX_PENDING>
+{
+public:
+  using length_t = typename Format::length_t;
+  using slot_t = typename Format::slot_t;
+  using send_cb = typename Format::send_cb;
+  using changed_cb = typename Format::changed_cb;
+  using sendCtx_cb = typename CallbackHooks<Format>::sendCtx_cb;
+  using changedCtx_cb = typename CallbackHooks<Format>::changedCtx_cb;
+  using doneCtx_cb = typename CallbackHooks<Format>::doneCtx_cb;
+  using sendVecCtx_cb = typename CallbackHooks<Format>::sendVecCtx_cb;
+
+  explicit SyncBusClient(send_cb SendData_cb,
+      changed_cb DataChanged_cb = nullptr,
+      SyncBusRequestDone_cb RequestDone_cb = nullptr) noexcept :
+      SyncBusClient(Hooks(SendData_cb, DataChanged_cb, RequestDone_cb))
+  {
+  }
+
+  // Callbacks receiving 'ctx' as their first argument
+  SyncBusClient(void *ctx, sendCtx_cb SendData_cb,
+      changedCtx_cb DataChanged_cb = nullptr,
+      doneCtx_cb RequestDone_cb = nullptr) noexcept :
+      SyncBusClient(Hooks(ctx, SendData_cb, DataChanged_cb, RequestDone_cb))
+  {
+  }
+
+  // Vectored send (see CallbackHooks): slot data is not staged
+  SyncBusClient(SyncBusVectored_t, SyncBusSendVec_cb SendVec_cb,
+      changed_cb DataChanged_cb = nullptr,
+      SyncBusRequestDone_cb RequestDone_cb = nullptr) noexcept :
+      SyncBusClient(Hooks(SyncBusVectored, SendVec_cb, DataChanged_cb,
+                          RequestDone_cb))
+  {
+  }
+
+  SyncBusClient(SyncBusVectored_t, void *ctx, sendVecCtx_cb SendVec_cb,
+      changedCtx_cb DataChanged_cb = nullptr,
+      doneCtx_cb RequestDone_cb = nullptr) noexcept :
+      SyncBusClient(Hooks(SyncBusVectored, ctx, SendVec_cb, DataChanged_cb,
+                          RequestDone_cb))
+  {
+  }
+
+  explicit SyncBusClient(const Hooks &hooks) noexcept :
+      frameTx_t<Format, Hooks>(hooks), pendingStore_t<SYNCBUS_MAX_PENDING>(),
+      m_numSlots(0U), m_numBulk(0U), m_nextTid(0U), m_waiter(nullptr),
+      m_now(0U), m_timeout(0U), m_maxTimeout(0U), m_maxRetries(0U)
+  {
+  }
+
+#if SYNCBUS_ENABLE_FRAME_POOL
+  using frameTx_t<Format, Hooks>::setFramePool;
+#endif
+
+  // GET request for a managed slot
+  result getData(uint32_t serverId, uint8_t slot) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+
+    if (m_serveSlots[slot].data == nullptr)
+    {
+      return result::errFault;
+    }
+
+    // total = header + crc
+    if ((static_cast<uint16_t>(HeaderSize) + 2U) > BufferSize)
+    {
+      return result::errOverflow;
+    }
+
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    uint16_t tid;
+    const result res = claimTid(serverId, slot, SyncBusFunc::GetReq, tid);
+    if (res != result::ok)
+    {
+      return res;
+    }
+
+    length_t size = buildFrame<Format>(m_buffer, serverId,
+                                       m_serveSlots[slot].slotId,
+                                       SyncBusFunc::GetReq, nullptr, 0U, tid);
+    transmit(size);
+    return result::ok;
+  }
+
+  // SET request for a managed slot (sends current local data of that slot)
+  result setData(uint32_t serverId, uint8_t slot) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+    if (m_serveSlots[slot].data == nullptr)
+    {
+      return result::errFault;
+    }
+
+    const length_t payload = m_serveSlots[slot].size;
+    const uint16_t totalNoCrc = static_cast<uint16_t>(HeaderSize)
+        + static_cast<uint16_t>(payload);
+
+    if (totalNoCrc + 2U > BufferSize)
+    {
+      return result::errOverflow;
+    }
+
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    uint16_t tid;
+    const result res = claimTid(serverId, slot, SyncBusFunc::SetReq, tid);
+    if (res != result::ok)
+    {
+      return res;
+    }
+
+    const length_t head = writeHeader<Format>(m_buffer, serverId,
+                                              m_serveSlots[slot].slotId,
+                                              SyncBusFunc::SetReq, tid);
+    m_serveSlots[slot].versionValid = false;
+    transmit(head, m_serveSlots[slot].data, payload);
+    return result::ok;
+  }
+
+  // Conditional GET: the server answers NotModified when the slot is still
+  // at the version this client last received, GetVerResp otherwise
+  result getDataIfModified(uint32_t serverId, uint8_t slot) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    uint16_t tid;
+    const result res = claimTid(serverId, slot, SyncBusFunc::GetIfModReq, tid);
+    if (res != result::ok)
+    {
+      return res;
+    }
+
+    const serverData_t<Format> &rec = m_serveSlots[slot];
+    uint8_t version[VersionSize];
+    write_le16(version, rec.version);
+    transmit(buildFrame<Format>(m_buffer, serverId, rec.slotId,
+                                SyncBusFunc::GetIfModReq, version,
+                                rec.versionValid ? VersionSize : 0U, tid));
+    return result::ok;
+  }
+
+  // Enable delta transfers for a slot; 'reference' is an application buffer
+  // of the slot's size holding the last value both sides agreed on
+  result enableDelta(uint8_t slot, void *reference) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+    if (reference == nullptr)
+    {
+      return result::errFault;
+    }
+    m_serveSlots[slot].reference = reference;
+    m_serveSlots[slot].refValid = false;
+    return result::ok;
+  }
+
+  // Delta GET: the server answers with patches against our reference
+  // (DeltaResp), NotModified, or the full value (GetVerResp)
+  result getDataDelta(uint32_t serverId, uint8_t slot) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+
+    const serverData_t<Format> &rec = m_serveSlots[slot];
+    if (rec.reference == nullptr)
+    {
+      return result::errFault;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    uint16_t tid;
+    const result res = claimTid(serverId, slot, SyncBusFunc::GetDeltaReq, tid);
+    if (res != result::ok)
+    {
+      return res;
+    }
+
+    uint8_t version[VersionSize];
+    write_le16(version, rec.refVersion);
+    transmit(buildFrame<Format>(m_buffer, serverId, rec.slotId,
+                                SyncBusFunc::GetDeltaReq, version,
+                                rec.refValid ? VersionSize : 0U, tid));
+    return result::ok;
+  }
+
+  // Delta SET: sends the local value as patches against the reference, or
+  // in full when the patches would not be smaller
+  result setDataDelta(uint32_t serverId, uint8_t slot) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+
+    serverData_t<Format> &rec = m_serveSlots[slot];
+    if (rec.reference == nullptr)
+    {
+      return result::errFault;
+    }
+
+    constexpr uint8_t Prefix = HeaderSize + 1U + VersionSize;
+    if ((static_cast<uint16_t>(Prefix) + rec.size + 2U) > BufferSize)
+    {
+      // no room for the delta prefix: plain SET
+      rec.refValid = false;
+      return setData(serverId, slot);
+    }
+
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    uint16_t tid;
+    const result res = claimTid(serverId, slot, SyncBusFunc::SetDeltaReq, tid);
+    if (res != result::ok)
+    {
+      return res;
+    }
+
+    const length_t len = writeHeader<Format>(m_buffer, serverId, rec.slotId,
+                                             SyncBusFunc::SetDeltaReq, tid);
+    const length_t prefix = static_cast<length_t>(len + 1U + VersionSize);
+    length_t patchLen = 0U;
+    const bool delta = rec.refValid
+        && encodeDelta<Format>(&m_buffer[prefix], patchLen,
+                               static_cast<const uint8_t*>(rec.reference),
+                               static_cast<const uint8_t*>(rec.data), rec.size,
+                               rec.size);
+    m_buffer[len] = delta ? 0U : DeltaFlagFull;
+    write_le16(&m_buffer[len + 1U], rec.refVersion);
+
+    // The sent value becomes the reference once the server acknowledges it
+    std::memcpy(rec.reference, rec.data, rec.size);
+    rec.refValid = false;
+    rec.versionValid = false;
+
+    if (delta)
+    {
+      transmit(genCRC16(m_buffer, static_cast<length_t>(prefix + patchLen)));
+    } else
+    {
+      transmit(prefix, rec.reference, rec.size);
+    }
+    return result::ok;
+  }
+
+  // ---- Pipelining ----------------------------------------------------------
+  // With SYNCBUS_MAX_PENDING > 0, single-slot GET/SET requests carry a
+  // transaction ID and stay pending until the response with that TID
+  // arrives, in any order. Requests return errBusy while the table is full;
+  // responses with an unknown TID (stale or duplicate) are dropped. Each
+  // request ends in one RequestDone callback (awaited requests resume their
+  // coroutine instead).
+
+  // A request unanswered for 'timeout' ticks is sent again with its TID,
+  // the wait doubling on every retry up to 'maxTimeout'; after 'retries'
+  // retransmissions it fails with errTimeout. A zero timeout (default)
+  // waits for the response indefinitely.
+  void setRetryPolicy(uint16_t timeout, uint8_t retries,
+      uint16_t maxTimeout) noexcept
+  {
+    m_timeout = timeout;
+    m_maxRetries = retries;
+    m_maxTimeout = (maxTimeout > timeout) ? maxTimeout : timeout;
+  }
+
+  // Timeouts and retransmissions; call with a monotonic tick (wrap-around
+  // safe). New requests are timed from the last tick passed here.
+  void poll(uint32_t now) noexcept
+  {
+    m_now = now;
+    for (uint8_t p = 0U; p < MaxPending; ++p)
+    {
+      pending_t &req = m_pending[p];
+      if (!req.used || (req.timeout == 0U)
+          || ((now - req.sentAt) < req.timeout))
+      {
+        continue;
+      }
+      if (req.retries >= m_maxRetries)
+      {
+        requestDone(p, result::errTimeout);
+        continue;
+      }
+      if (!txReady())
+      {
+        continue;  // retried on a later poll
+      }
+      ++req.retries;
+      req.timeout = (req.timeout > (m_maxTimeout / 2U)) ? m_maxTimeout
+          : static_cast<uint16_t>(req.timeout * 2U);
+      retransmit(p);
+    }
+  }
+
+  // Requests still waiting for their response
+  uint8_t pending() const noexcept
+  {
+    uint8_t count = 0U;
+    for (uint8_t p = 0U; p < MaxPending; ++p)
+    {
+      if (m_pending[p].used)
+      {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  // Forget all outstanding requests (e.g. after a link reset) without
+  // callbacks; their late responses are then dropped. Awaiting coroutines
+  // resume with errTimeout.
+  void clearPending() noexcept
+  {
+#if SYNCBUS_ENABLE_COROUTINES
+    // Resumed only once the table is clear: a coroutine may await again
+    // from its resumption and claim any entry
+    void *waiters[(MaxPending > 0U) ? MaxPending : 1U];
+    uint8_t numWaiters = 0U;
+#endif
+    for (uint8_t p = 0U; p < MaxPending; ++p)
+    {
+#if SYNCBUS_ENABLE_COROUTINES
+      if (m_pending[p].used && (m_pending[p].waiter != nullptr))
+      {
+        waiters[numWaiters++] = m_pending[p].waiter;
+      }
+#endif
+      m_pending[p].used = false;
+    }
+#if SYNCBUS_ENABLE_COROUTINES
+    for (uint8_t w = 0U; w < numWaiters; ++w)
+    {
+      resumeWaiter(waiters[w], result::errTimeout);
+    }
+#endif
+  }
+
+#if SYNCBUS_ENABLE_COROUTINES
+  // ---- Coroutines ----------------------------------------------------------
+  // 'result r = co_await client.get(serverId, slot);' sends the request and
+  // resumes the coroutine from inputData (response matched) or poll
+  // (errTimeout) with the outcome, instead of a RequestDone callback. The
+  // awaiter lives in the coroutine frame, so requests use no heap. Requests
+  // are tracked by TID (SYNCBUS_MAX_PENDING > 0): one that cannot be
+  // (table full, slot too large) resumes at once with errBusy/errFault.
+  class Awaiter
+  {
+  public:
+    bool await_ready() const noexcept
+    {
+      return false;
+    }
+
+    // false (resume at once) when the request was not sent
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+      m_handle = handle;
+      return m_client.awaitRequest(*this);
+    }
+
+    result await_resume() const noexcept
+    {
+      return m_result;
+    }
+
+  private:
+    friend class SyncBusClient;
+
+    Awaiter(SyncBusClient &client, uint32_t serverId, uint8_t slot,
+        SyncBusFunc function) noexcept :
+        m_client(client), m_serverId(serverId), m_slot(slot), m_function(
+            function), m_result(result::ok), m_handle()
+    {
+    }
+
+    SyncBusClient &m_client;
+    uint32_t m_serverId;
+    uint8_t m_slot;
+    SyncBusFunc m_function;
+    result m_result;
+    std::coroutine_handle<> m_handle;
+  };
+
+  // Awaitable GET; resumes once the slot data has been updated
+  Awaiter get(uint32_t serverId, uint8_t slot) noexcept
+  {
+    return Awaiter(*this, serverId, slot, SyncBusFunc::GetReq);
+  }
+
+  // Awaitable SET; resumes on the server's SetResp
+  Awaiter set(uint32_t serverId, uint8_t slot) noexcept
+  {
+    return Awaiter(*this, serverId, slot, SyncBusFunc::SetReq);
+  }
+#endif
+
+  // ---- Bulk transfers ------------------------------------------------------
+  // Slots larger than one frame move as windows of SYNCBUS_BULK_WINDOW
+  // fragments; the frame buffer stays BufferSize bytes.
+
+  // Start a fragmented GET of a bulk slot (index in registration order)
+  result getBulk(uint8_t bulk) noexcept
+  {
+    if (bulk >= m_numBulk)
+    {
+      return result::errOverflow;
+    }
+    if (m_bulk[bulk].state != BulkIdle)
+    {
+      return result::errFault;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    m_bulk[bulk].state = BulkGetting;
+    m_bulk[bulk].next = 0U;
+    requestWindow(bulk);
+    return result::ok;
+  }
+
+  // Start a fragmented SET of a bulk slot with its current local data
+  result setBulk(uint8_t bulk) noexcept
+  {
+    if (bulk >= m_numBulk)
+    {
+      return result::errOverflow;
+    }
+    if (m_bulk[bulk].state != BulkIdle)
+    {
+      return result::errFault;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    m_bulk[bulk].state = BulkSetting;
+    m_bulk[bulk].next = 0U;
+    sendWindow(bulk);
+    return result::ok;
+  }
+
+  // Repeat the current window after a lost fragment or acknowledgement
+  result resumeBulk(uint8_t bulk) noexcept
+  {
+    if (bulk >= m_numBulk)
+    {
+      return result::errOverflow;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    if (m_bulk[bulk].state == BulkGetting)
+    {
+      requestWindow(bulk);
+    } else if (m_bulk[bulk].state == BulkSetting)
+    {
+      sendWindow(bulk);
+    } else
+    {
+      return result::errFault;
+    }
+    return result::ok;
+  }
+
+  bool bulkBusy(uint8_t bulk) const noexcept
+  {
+    return (bulk < m_numBulk) && (m_bulk[bulk].state != BulkIdle);
+  }
+
+  // Register a bulk slot; 'staging' (optional, 'size' bytes) holds a GET in
+  // progress so 'data' is only overwritten by a complete transfer
+  result addBulkData(void *data, uint32_t serverId, slot_t slotId,
+      uint16_t size, void *staging = nullptr) noexcept
+  {
+    if ((data == nullptr) || (size == 0U))
+    {
+      return result::errFault;
+    }
+    if (m_numBulk >= numBulk)
+    {
+      return result::errOverflow;
+    }
+    if (findBulk(serverId, slotId) != NoSlot)
+    {
+      return result::errDuplicate;
+    }
+
+    bulkData_t<Format> &rec = m_bulk[m_numBulk];
+    rec.data = data;
+    rec.staging = staging;
+    rec.serverId = serverId;
+    rec.slotId = slotId;
+    rec.size = size;
+    rec.next = 0U;
+    rec.state = BulkIdle;
+    ++m_numBulk;
+
+    return result::ok;
+  }
+
+  // GET several managed slots of one server with a single request; 'slots'
+  // are local slot indices. The server answers with one or more
+  // GetMultiResp frames.
+  result getMultiData(uint32_t serverId, const uint8_t *slots,
+      uint8_t count) noexcept
+  {
+    if ((slots == nullptr) || (count == 0U))
+    {
+      return result::errFault;
+    }
+    if ((static_cast<uint16_t>(HeaderSize) + count * sizeof(slot_t) + 2U)
+        > BufferSize)
+    {
+      return result::errOverflow;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+
+    length_t len = writeHeader<Format>(m_buffer, serverId, count,
+                                       SyncBusFunc::GetMultiReq);
+    for (uint8_t n = 0U; n < count; ++n)
+    {
+      if (slots[n] >= m_numSlots)
+      {
+        return result::errOverflow;
+      }
+      Format::writeField(&m_buffer[len], m_serveSlots[slots[n]].slotId);
+      len = static_cast<length_t>(len + sizeof(slot_t));
+    }
+
+    transmit(genCRC16(m_buffer, len));
+    return result::ok;
+  }
+
+  // SET several managed slots of one server, packing [slotId][len][data]
+  // records into as few SetMultiReq frames as fit; 'slots' are local slot
+  // indices. The server applies each frame as a unit and acknowledges it
+  // with one SetMultiResp.
+  result setMultiData(uint32_t serverId, const uint8_t *slots,
+      uint8_t count) noexcept
+  {
+    if ((slots == nullptr) || (count == 0U))
+    {
+      return result::errFault;
+    }
+    for (uint8_t n = 0U; n < count; ++n)
+    {
+      if (slots[n] >= m_numSlots)
+      {
+        return result::errOverflow;
+      }
+      if ((static_cast<uint16_t>(HeaderSize) + RecordHeaderSize
+          + m_serveSlots[slots[n]].size + 2U) > BufferSize)
+      {
+        return result::errOverflow;
+      }
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+
+    uint8_t first = 0U;
+    while (first < count)
+    {
+      // how many records fit in this frame
+      size_t len = HeaderSize;
+      uint8_t last = first;
+      while ((last < count)
+          && ((len + RecordHeaderSize + m_serveSlots[slots[last]].size + 2U)
+              <= BufferSize))
+      {
+        len += RecordHeaderSize + m_serveSlots[slots[last]].size;
+        ++last;
+      }
+
+      length_t pos = writeHeader<Format>(m_buffer, serverId,
+                                         static_cast<slot_t>(last - first),
+                                         SyncBusFunc::SetMultiReq);
+      Crc16State crc;
+      crc.update(m_buffer, pos);
+      for (uint8_t n = first; n < last; ++n)
+      {
+        serverData_t<Format> &rec = m_serveSlots[slots[n]];
+        rec.versionValid = false;
+        Format::writeField(&m_buffer[pos], rec.slotId);
+        Format::writeField(&m_buffer[pos + sizeof(slot_t)], rec.size);
+        crc.update(&m_buffer[pos], RecordHeaderSize);
+        pos = static_cast<length_t>(pos + RecordHeaderSize);
+        crc.copy(&m_buffer[pos], rec.data, rec.size);
+        pos = static_cast<length_t>(pos + rec.size);
+      }
+      transmit(putCRC16(m_buffer, pos, crc.finalize()));
+      first = last;
+    }
+    return result::ok;
+  }
+
+  // Ask the server to push this slot (as GetResp frames) whenever it
+  // notifies a change and, if 'period' is non-zero, every 'period' ticks
+  result subscribe(uint32_t serverId, uint8_t slot, uint16_t period = 0U) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+
+    uint8_t payload[2];
+    write_le16(payload, period);
+    transmit(buildFrame<Format>(m_buffer, serverId, m_serveSlots[slot].slotId,
+                                SyncBusFunc::Subscribe, payload,
+                                sizeof(payload)));
+    return result::ok;
+  }
+
+  result unsubscribe(uint32_t serverId, uint8_t slot) noexcept
+  {
+    if (slot >= m_numSlots)
+    {
+      return result::errOverflow;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+
+    transmit(buildFrame<Format>(m_buffer, serverId, m_serveSlots[slot].slotId,
+                                SyncBusFunc::Unsubscribe, nullptr, 0U));
+    return result::ok;
+  }
+
+  // GET request through a typed handle (uses the registered serverId)
+  template<typename T>
+  result getData(TypedSlot<T, Format> slot) noexcept
+  {
+    if (!slot.valid() || (slot.index >= m_numSlots))
+    {
+      return result::errFault;
+    }
+    return getData(m_serveSlots[slot.index].serverId, slot.index);
+  }
+
+  // SET request through a typed handle; payload size is sizeof(T)
+  template<typename T>
+  result setData(TypedSlot<T, Format> slot) noexcept
+  {
+    if (!slot.valid() || (slot.index >= m_numSlots))
+    {
+      return result::errFault;
+    }
+
+    serverData_t<Format> &rec = m_serveSlots[slot.index];
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    uint16_t tid;
+    const result res = claimTid(rec.serverId, slot.index,
+                                SyncBusFunc::SetReq, tid);
+    if (res != result::ok)
+    {
+      return res;
+    }
+
+    const length_t head = writeHeader<Format>(m_buffer, rec.serverId,
+                                              rec.slotId, SyncBusFunc::SetReq,
+                                              tid);
+    rec.versionValid = false;
+    transmit(head, rec.data, static_cast<length_t>(sizeof(T)));
+    return result::ok;
+  }
+
+  // Incoming data (GetResp / SetResp)
+  result inputData(const uint8_t *data, length_t size) noexcept
+  {
+    if (size < static_cast<length_t>(HeaderSize + 2U))
+    {
+      return result::errFault;
+    }
+    if (!checkCRC16(data, size))
+    {
+      return result::errCrc;
+    }
+
+    const uint32_t serverId = read_le32(&data[FrameServerId]);
+    const auto function = static_cast<SyncBusFunc>(data[FrameFunction]
+        & static_cast<uint8_t>(~FuncFlagTid));
+    const slot_t slotId = Format::readField(&data[FrameSlotId]);
+
+    const bool tagged = (data[FrameFunction] & FuncFlagTid) != 0U;
+    const uint8_t dataAt = tagged ? (FrameData + TidSize) : FrameData;
+    if (size < static_cast<length_t>(dataAt + 2U))
+    {
+      return result::errFault;
+    }
+    const uint8_t *payload = &data[dataAt];
+    const length_t payloadLen = static_cast<length_t>(size - dataAt - 2U);
+
+    // The TID (right after the header) names the outstanding request this
+    // frame answers; unknown TIDs are stale or duplicate responses
+    uint8_t p = NoSlot;
+    if (tagged)
+    {
+      p = findPending(serverId, data[HeaderSize]);
+      if (p == NoSlot)
+      {
+        return result::ok;
+      }
+    }
+
+    result res = result::errFault;
+    if ((p == NoSlot) || (m_serveSlots[m_pending[p].slot].slotId == slotId))
+    {
+      res = dispatch(serverId, slotId, function, payload, payloadLen, p);
+    }
+    if (p != NoSlot)
+    {
+      requestDone(p, res);
+    }
+    return res;
+  }
+
+  // Register a typed (serverId, slotId, data*); size is sizeof(T)
+  template<typename T>
+  TypedSlot<T, Format> addData(T *data, uint32_t serverId,
+      slot_t slotId) noexcept
+  {
+    const uint8_t index = m_numSlots;
+    if (addData(static_cast<void*>(data), serverId, slotId,
+                static_cast<length_t>(sizeof(T))) != result::ok)
+    {
+      return TypedSlot<T, Format> { NoSlot };
+    }
+    return TypedSlot<T, Format> { index };
+  }
+
+  // Register a (serverId, slotId, size, data*)
+  result addData(void *data, uint32_t serverId, slot_t slotId,
+      length_t size) noexcept
+  {
+    if (data == nullptr)
+    {
+      return result::errFault;
+    }
+    if (m_numSlots >= numSlots)
+    {
+      return result::errOverflow;
+    }
+
+    // enforce maximum payload per frame
+    if ((static_cast<uint16_t>(HeaderSize) + size + 2U) > BufferSize)
+    {
+      return result::errOverflow;
+    }
+    if (findData(serverId, slotId) != NoSlot)
+    {
+      return result::errDuplicate;
+    }
+
+    m_serveSlots[m_numSlots].data = data;
+    m_serveSlots[m_numSlots].serverId = serverId;
+    m_serveSlots[m_numSlots].slotId = slotId;
+    m_serveSlots[m_numSlots].size = size;
+    m_serveSlots[m_numSlots].version = 0U;
+    m_serveSlots[m_numSlots].versionValid = false;
+    m_serveSlots[m_numSlots].reference = nullptr;
+    m_serveSlots[m_numSlots].refVersion = 0U;
+    m_serveSlots[m_numSlots].refValid = false;
+
+    // insertion into the (serverId, slotId)-ordered index
+    const uint64_t key = slotKey(serverId, slotId);
+    uint8_t pos = m_numSlots;
+    while ((pos > 0U) && (slotKey(m_keyIndex[pos - 1U]) > key))
+    {
+      m_keyIndex[pos] = m_keyIndex[pos - 1U];
+      --pos;
+    }
+    m_keyIndex[pos] = m_numSlots;
+    ++m_numSlots;
+
+    return result::ok;
+  }
+
+private:
+  using frameTx_t<Format, Hooks>::m_hooks;
+  using frameTx_t<Format, Hooks>::m_buffer;
+  using frameTx_t<Format, Hooks>::transmit;
+  using frameTx_t<Format, Hooks>::txReady;
+  using bulkStore_t<bulkData_t<Format>, numBulk>::m_bulk;
+  using pendingStore_t<SYNCBUS_MAX_PENDING>::m_pending;
+
+  // Handle one response. 'p' is the pending request it answers (NoSlot if
+  // untagged); it is set to NoSlot when that request continues (resent).
+  result dispatch(uint32_t serverId, slot_t slotId, SyncBusFunc function,
+      const uint8_t *payload, length_t payloadLen, uint8_t &p) noexcept
+  {
+    if ((function == SyncBusFunc::BulkGetResp)
+        || (function == SyncBusFunc::BulkSetResp))
+    {
+      return bulkInput(serverId, slotId, function, payload, payloadLen);
+    }
+
+    if (function == SyncBusFunc::GetResp)
+    {
+      const uint8_t i = findData(serverId, slotId);
+      if (i != NoSlot)
+      {
+        if (payloadLen != m_serveSlots[i].size)
+        {
+          return result::errFault;
+        }
+        copySlot(m_serveSlots[i].data, payload, payloadLen);
+        m_serveSlots[i].versionValid = false;
+        m_serveSlots[i].refValid = false;
+
+        m_hooks.changed(serverId, slotId, i);
+      }
+    } else if (function == SyncBusFunc::GetVerResp)
+    {
+      const uint8_t i = findData(serverId, slotId);
+      if (i != NoSlot)
+      {
+        if (payloadLen != (VersionSize + m_serveSlots[i].size))
+        {
+          return result::errFault;
+        }
+        copySlot(m_serveSlots[i].data, &payload[VersionSize],
+                 m_serveSlots[i].size);
+        m_serveSlots[i].version = read_le16(payload);
+        m_serveSlots[i].versionValid = true;
+        updateReference(i);
+
+        m_hooks.changed(serverId, slotId, i);
+      }
+    } else if (function == SyncBusFunc::NotModified)
+    {
+      // Local copy is current; nothing to do
+    } else if (function == SyncBusFunc::DeltaResp)
+    {
+      const uint8_t i = findData(serverId, slotId);
+      if ((i != NoSlot) && (payloadLen >= (2U * VersionSize)))
+      {
+        serverData_t<Format> &rec = m_serveSlots[i];
+        uint8_t *ref = static_cast<uint8_t*>(rec.reference);
+        if ((ref == nullptr) || !rec.refValid
+            || (read_le16(payload) != rec.refVersion)
+            || !applyDelta<Format>(ref, rec.size,
+                &payload[2U * VersionSize],
+                static_cast<length_t>(payloadLen - 2U * VersionSize)))
+        {
+          // Out of sync: the next delta GET fetches the full value
+          rec.refValid = false;
+          rec.versionValid = false;
+          return result::errFault;
+        }
+        std::memcpy(rec.data, ref, rec.size);
+        rec.refVersion = read_le16(&payload[VersionSize]);
+        rec.version = rec.refVersion;
+        rec.versionValid = true;
+
+        m_hooks.changed(serverId, slotId, i);
+      }
+    } else if (function == SyncBusFunc::SetDeltaResp)
+    {
+      const uint8_t i = findData(serverId, slotId);
+      if ((i != NoSlot) && (payloadLen == (1U + VersionSize))
+          && (m_serveSlots[i].reference != nullptr))
+      {
+        if (payload[0] != 0U)
+        {
+          m_serveSlots[i].refVersion = read_le16(&payload[1U]);
+          m_serveSlots[i].refValid = true;
+        } else if (p != NoSlot)
+        {
+          // Server moved past our base version: the pending request goes
+          // out again, in full
+          m_serveSlots[i].refValid = false;
+          retransmit(p);
+          p = NoSlot;
+        } else
+        {
+          // Server moved past our base version: resend in full
+          m_serveSlots[i].refValid = false;
+          return setDataDelta(serverId, i);
+        }
+      }
+    } else if (function == SyncBusFunc::GetMultiResp)
+    {
+      // FrameSlotId carries the record count
+      length_t off = 0U;
+      for (length_t r = 0U; r < slotId; ++r)
+      {
+        if ((off + RecordHeaderSize) > payloadLen)
+        {
+          return result::errFault;
+        }
+        const slot_t recSlotId = Format::readField(&payload[off]);
+        const length_t recLen = Format::readField(
+            &payload[off + sizeof(slot_t)]);
+        off = static_cast<length_t>(off + RecordHeaderSize);
+        if ((off + recLen) > payloadLen)
+        {
+          return result::errFault;
+        }
+
+        const uint8_t i = findData(serverId, recSlotId);
+        if ((i != NoSlot) && (recLen == m_serveSlots[i].size))
+        {
+          copySlot(m_serveSlots[i].data, &payload[off], recLen);
+          m_serveSlots[i].versionValid = false;
+          m_serveSlots[i].refValid = false;
+          m_hooks.changed(serverId, recSlotId, i);
+        }
+        off = static_cast<length_t>(off + recLen);
+      }
+    } else if ((function == SyncBusFunc::SetResp)
+        || (function == SyncBusFunc::SetMultiResp))
+    {
+      // Optional: handle ACK, e.g., notify or update a status map
+      // A tagged ACK completes its pending request (inputData); otherwise
+      // no state is kept → treated as success notification.
+    }
+
+    return result::ok;
+  }
+
+  // Ask for the next window of a bulk GET, starting at the first missing byte
+  void requestWindow(uint8_t bulk) noexcept
+  {
+    uint8_t req[3];
+    write_le16(req, m_bulk[bulk].next);
+    req[2] = SYNCBUS_BULK_WINDOW;
+    transmit(buildFrame<Format>(m_buffer, m_bulk[bulk].serverId,
+                                m_bulk[bulk].slotId, SyncBusFunc::BulkGetReq,
+                                req, sizeof(req)));
+  }
+
+  // Send one window of a bulk SET from the last acknowledged byte; the
+  // server acknowledges the fragment flagged as window end
+  void sendWindow(uint8_t bulk) noexcept
+  {
+    const bulkData_t<Format> &rec = m_bulk[bulk];
+    uint16_t offset = rec.next;
+    for (uint8_t n = 0U; (n < SYNCBUS_BULK_WINDOW) && (offset < rec.size); ++n)
+    {
+      const uint16_t left = static_cast<uint16_t>(rec.size - offset);
+      const length_t len = (left < FragPayloadMax) ? static_cast<length_t>(left)
+                                                   : FragPayloadMax;
+      const bool last = ((n + 1U) == SYNCBUS_BULK_WINDOW)
+          || ((offset + len) == rec.size);
+      transmit(writeFragmentHeader<Format>(m_buffer, rec.serverId,
+                                           rec.slotId, SyncBusFunc::BulkSetReq,
+                                           rec.size, offset,
+                                           last ? FragFlagWindowEnd : 0U),
+               static_cast<const uint8_t*>(rec.data) + offset, len);
+      offset = static_cast<uint16_t>(offset + len);
+    }
+  }
+
+  // BulkGetResp fragments (reassembled in order; anything after a gap is
+  // dropped and fetched again with the next window) and BulkSetResp acks
+  result bulkInput(uint32_t serverId, slot_t slotId, SyncBusFunc function,
+      const uint8_t *payload, length_t payloadLen) noexcept
+  {
+    const uint8_t b = findBulk(serverId, slotId);
+    if (b == NoSlot)
+    {
+      return result::ok;
+    }
+    bulkData_t<Format> &rec = m_bulk[b];
+
+    if (function == SyncBusFunc::BulkSetResp)
+    {
+      if ((rec.state != BulkSetting) || (payloadLen != 2U))
+      {
+        return result::ok;
+      }
+      const uint16_t acked = read_le16(payload);
+      if (acked >= rec.size)
+      {
+        rec.state = BulkIdle;
+        return result::ok;
+      }
+      rec.next = acked;
+      sendWindow(b);
+      return result::ok;
+    }
+
+    if ((rec.state != BulkGetting) || (payloadLen < FragHeaderSize))
+    {
+      return result::ok;
+    }
+    const uint16_t offset = read_le16(payload);
+    const length_t len = static_cast<length_t>(payloadLen - FragHeaderSize);
+    if ((read_le16(&payload[2]) != rec.size) || ((offset + len) > rec.size))
+    {
+      rec.state = BulkIdle;
+      return result::errFault;
+    }
+
+    if (offset == rec.next)
+    {
+      void *dst = (rec.staging != nullptr) ? rec.staging : rec.data;
+      std::memcpy(static_cast<uint8_t*>(dst) + offset,
+                  &payload[FragHeaderSize], len);
+      rec.next = static_cast<uint16_t>(rec.next + len);
+    }
+
+    if (rec.next == rec.size)
+    {
+      rec.state = BulkIdle;
+      if (rec.staging != nullptr)
+      {
+        std::memcpy(rec.data, rec.staging, rec.size);
+      }
+      m_hooks.changed(serverId, slotId, b);
+    } else if ((payload[4] & FragFlagWindowEnd) != 0U)
+    {
+      requestWindow(b);
+    }
+    return result::ok;
+  }
+
+  uint8_t findBulk(uint32_t serverId, slot_t slotId) const noexcept
+  {
+    for (uint8_t b = 0U; b < m_numBulk; ++b)
+    {
+      if ((m_bulk[b].serverId == serverId) && (m_bulk[b].slotId == slotId))
+      {
+        return b;
+      }
+    }
+    return NoSlot;
+  }
+
+  // TID for a request on 'slot', with a pending entry claimed for it.
+  // NoTid (untagged, not tracked) when pipelining is off or the slot leaves
+  // no room for the TID in its largest frame (SetDeltaReq with full data).
+  result claimTid(uint32_t serverId, uint8_t slot, SyncBusFunc function,
+      uint16_t &tid) noexcept
+  {
+    tid = NoTid;
+    if ((MaxPending == 0U)
+        || ((static_cast<uint16_t>(HeaderSize) + TidSize + 1U + VersionSize
+            + m_serveSlots[slot].size + 2U) > BufferSize))
+    {
+      // an awaited request must be tracked
+      return (m_waiter != nullptr) ? result::errFault : result::ok;
+    }
+
+    for (uint8_t p = 0U; p < MaxPending; ++p)
+    {
+      if (!m_pending[p].used)
+      {
+        // MaxPending < 256, so a free TID always exists
+        uint8_t next = m_nextTid++;
+        while (findPending(serverId, next) != NoSlot)
+        {
+          next = m_nextTid++;
+        }
+        m_pending[p].serverId = serverId;
+        m_pending[p].sentAt = m_now;
+        m_pending[p].timeout = m_timeout;
+        m_pending[p].slot = slot;
+        m_pending[p].tid = next;
+        m_pending[p].function = static_cast<uint8_t>(function);
+        m_pending[p].retries = 0U;
+        m_pending[p].used = true;
+        m_pending[p].waiter = m_waiter;
+        tid = next;
+        return result::ok;
+      }
+    }
+    return result::errBusy;
+  }
+
+  // Send the request of pending entry 'p' again with its TID. SetDeltaReq
+  // goes out in full, from the reference (the value first sent).
+  void retransmit(uint8_t p) noexcept
+  {
+    pending_t &req = m_pending[p];
+    const serverData_t<Format> &rec = m_serveSlots[req.slot];
+    const auto function = static_cast<SyncBusFunc>(req.function);
+    uint8_t version[VersionSize];
+    req.sentAt = m_now;
+
+    if (function == SyncBusFunc::SetReq)
+    {
+      transmit(writeHeader<Format>(m_buffer, req.serverId, rec.slotId,
+                                   SyncBusFunc::SetReq, req.tid), rec.data,
+               rec.size);
+    } else if (function == SyncBusFunc::GetIfModReq)
+    {
+      write_le16(version, rec.version);
+      transmit(buildFrame<Format>(m_buffer, req.serverId, rec.slotId,
+                                  SyncBusFunc::GetIfModReq, version,
+                                  rec.versionValid ? VersionSize : 0U,
+                                  req.tid));
+    } else if (function == SyncBusFunc::GetDeltaReq)
+    {
+      write_le16(version, rec.refVersion);
+      transmit(buildFrame<Format>(m_buffer, req.serverId, rec.slotId,
+                                  SyncBusFunc::GetDeltaReq, version,
+                                  rec.refValid ? VersionSize : 0U, req.tid));
+    } else if (function == SyncBusFunc::SetDeltaReq)
+    {
+      const length_t len = writeHeader<Format>(m_buffer, req.serverId,
+                                               rec.slotId,
+                                               SyncBusFunc::SetDeltaReq,
+                                               req.tid);
+      m_buffer[len] = DeltaFlagFull;
+      write_le16(&m_buffer[len + 1U], rec.refVersion);
+      transmit(static_cast<length_t>(len + 1U + VersionSize), rec.reference,
+               rec.size);
+    } else
+    {
+      transmit(buildFrame<Format>(m_buffer, req.serverId, rec.slotId,
+                                  SyncBusFunc::GetReq, nullptr, 0U, req.tid));
+    }
+  }
+
+  // Release pending entry 'p' and report its outcome
+  void requestDone(uint8_t p, result status) noexcept
+  {
+    m_pending[p].used = false;
+#if SYNCBUS_ENABLE_COROUTINES
+    if (m_pending[p].waiter != nullptr)
+    {
+      resumeWaiter(m_pending[p].waiter, status);
+      return;
+    }
+#endif
+    m_hooks.done(m_pending[p].serverId, m_pending[p].slot, status);
+  }
+
+#if SYNCBUS_ENABLE_COROUTINES
+  static void resumeWaiter(void *awaiter, result status) noexcept
+  {
+    Awaiter &waiter = *static_cast<Awaiter*>(awaiter);
+    waiter.m_result = status;
+    waiter.m_handle.resume();
+  }
+#endif
+
+#if SYNCBUS_ENABLE_COROUTINES
+  // Send the request of 'waiter' with the awaiter attached to its pending
+  // entry; false (no suspension) with the error when it was not sent
+  bool awaitRequest(Awaiter &waiter) noexcept
+  {
+    m_waiter = &waiter;
+    const result res = (waiter.m_function == SyncBusFunc::SetReq)
+        ? setData(waiter.m_serverId, waiter.m_slot)
+        : getData(waiter.m_serverId, waiter.m_slot);
+    m_waiter = nullptr;
+    if (res != result::ok)
+    {
+      waiter.m_result = res;
+      return false;
+    }
+    return true;
+  }
+#endif
+
+  uint8_t findPending(uint32_t serverId, uint8_t tid) const noexcept
+  {
+    for (uint8_t p = 0U; p < MaxPending; ++p)
+    {
+      if (m_pending[p].used && (m_pending[p].tid == tid)
+          && (m_pending[p].serverId == serverId))
+      {
+        return p;
+      }
+    }
+    return NoSlot;
+  }
+
+  // 'data' now holds server version 'version': make it the delta reference
+  void updateReference(uint8_t i) noexcept
+  {
+    serverData_t<Format> &rec = m_serveSlots[i];
+    if (rec.reference != nullptr)
+    {
+      std::memcpy(rec.reference, rec.data, rec.size);
+      rec.refVersion = rec.version;
+      rec.refValid = true;
+    }
+  }
+
+  // Lookup key: serverId in the upper bits, slotId in the low 8/16 bits
+  static uint64_t slotKey(uint32_t serverId, slot_t slotId) noexcept
+  {
+    return (static_cast<uint64_t>(serverId) << (8U * sizeof(slot_t))) | slotId;
+  }
+
+  uint64_t slotKey(uint8_t index) const noexcept
+  {
+    return slotKey(m_serveSlots[index].serverId, m_serveSlots[index].slotId);
+  }
+
+  // Index into m_serveSlots for (serverId, slotId), or NoSlot
+  uint8_t findData(uint32_t serverId, slot_t slotId) const noexcept
+  {
+    const uint64_t key = slotKey(serverId, slotId);
+    uint8_t lo = 0U;
+    uint8_t hi = m_numSlots;
+    while (lo < hi)
+    {
+      const uint8_t mid = static_cast<uint8_t>((lo + hi) / 2U);
+      const uint64_t midKey = slotKey(m_keyIndex[mid]);
+      if (midKey == key)
+      {
+        return m_keyIndex[mid];
+      }
+      if (midKey < key)
+      {
+        lo = static_cast<uint8_t>(mid + 1U);
+      } else
+      {
+        hi = mid;
+      }
+    }
+    return NoSlot;
+  }
+
+  // Wire layout of the selected Format (hides the CompactFrame constants)
+  static constexpr uint8_t FrameSlotId = Format::FrameSlotId;
+  static constexpr uint8_t FrameFunction = Format::FrameFunction;
+  static constexpr uint8_t FrameData = Format::FrameData;
+  static constexpr uint8_t HeaderSize = Format::HeaderSize;
+  static constexpr uint8_t RecordHeaderSize = Format::RecordHeaderSize;
+  static constexpr size_t BufferSize = Format::BufferSize;
+  static constexpr length_t FragPayloadMax = Format::FragPayloadMax;
+
+  static constexpr uint8_t MaxPending = SYNCBUS_MAX_PENDING;
+  static_assert(SYNCBUS_MAX_PENDING < NoSlot,
+                "SYNCBUS_MAX_PENDING must be below 255");
+
+  uint8_t m_numSlots;
+  serverData_t<Format> m_serveSlots[numSlots];
+  uint8_t m_keyIndex[numSlots];  // indices into m_serveSlots by key
+  uint8_t m_numBulk;
+  uint8_t m_nextTid;  // next transaction ID to hand out
+  void *m_waiter;     // awaiter of the request being sent, or nullptr
+  uint32_t m_now;     // last tick passed to poll()
+  uint16_t m_timeout;     // retry policy (setRetryPolicy)
+  uint16_t m_maxTimeout;
+  uint8_t m_maxRetries;
+};
+
+// ============================================================================
+//                                SERVER
+// ============================================================================
+template<uint8_t numSlots, uint8_t numBulk = 0U,
+    typename Format = CompactFrame, typename Hooks = CallbackHooks<Format>>
+class SyncBusServer: private frameTx_t<Format, Hooks>,
+    private bulkStore_t<bulkSlot_t<Format>, numBulk>
+{
+public:
+  using length_t = typename Format::length_t;
+  using slot_t = typename Format::slot_t;
+  using send_cb = typename Format::send_cb;
+  using changed_cb = typename Format::changed_cb;
+  using sendCtx_cb = typename CallbackHooks<Format>::sendCtx_cb;
+  using changedCtx_cb = typename CallbackHooks<Format>::changedCtx_cb;
+  using sendVecCtx_cb = typename CallbackHooks<Format>::sendVecCtx_cb;
+
+  explicit SyncBusServer(uint32_t id) noexcept :
+      SyncBusServer(id, Hooks())
+  {
+  }
+
+  SyncBusServer(uint32_t id, send_cb SendData_cb,
+      changed_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusServer(id, Hooks(SendData_cb, DataChanged_cb))
+  {
+  }
+
+  // Callbacks receiving 'ctx' as their first argument
+  SyncBusServer(uint32_t id, void *ctx, sendCtx_cb SendData_cb,
+      changedCtx_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusServer(id, Hooks(ctx, SendData_cb, DataChanged_cb))
+  {
+  }
+
+  // Vectored send (see CallbackHooks): slot data is not staged
+  SyncBusServer(SyncBusVectored_t, uint32_t id,
+      SyncBusSendVec_cb SendVec_cb, changed_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusServer(id, Hooks(SyncBusVectored, SendVec_cb, DataChanged_cb))
+  {
+  }
+
+  SyncBusServer(SyncBusVectored_t, uint32_t id, void *ctx,
+      sendVecCtx_cb SendVec_cb, changedCtx_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusServer(id, Hooks(SyncBusVectored, ctx, SendVec_cb, DataChanged_cb))
+  {
+  }
+
+  SyncBusServer(uint32_t id, const Hooks &hooks) noexcept :
+      frameTx_t<Format, Hooks>(hooks), m_serverId(id), m_numSlots(0U), m_numBulk(
+          0U), m_dirty { }, m_stale { }, m_now(0U), m_tid(NoTid)
+  {
+#if SYNCBUS_ENABLE_SEQLOCK
+    for (uint8_t i = 0U; i < numSlots; ++i)
+    {
+      m_seq[i].store(0U, std::memory_order_relaxed);
+      m_seen[i] = 0U;
+    }
+#endif
+    initIndex();
+  }
+
+#if SYNCBUS_ENABLE_FRAME_POOL
+  using frameTx_t<Format, Hooks>::setFramePool;
+#endif
+
+  void setId(uint32_t serverId) noexcept
+  {
+    m_serverId = serverId;
+  }
+
+  // Application changed a slot: push it to subscribers now
+  result notify(slot_t slotId) noexcept
+  {
+    const uint8_t i = findSlot(slotId);
+    if (i == NoSlot)
+    {
+      return result::errFault;
+    }
+    if (m_clientSlots[i].subscribers == 0U)
+    {
+      return result::ok;
+    }
+    if (!txReady())
+    {
+      return result::errBusy;
+    }
+    clearDirtyIndex(i);
+    return replySlot(i);
+  }
+
+#if SYNCBUS_ENABLE_SEQLOCK
+  // ---- Concurrent slots ----------------------------------------------------
+  // Other threads write a slot only through publish() and read it through
+  // snapshot() while the bus thread runs inputData/poll/notify. Frames are
+  // encoded from consistent copies and incoming SETs are written under the
+  // same per-slot seqlock. The bus thread takes published values as
+  // changes (new version, dirty, pushed to subscribers by poll). Writers
+  // spin while another one holds the slot and readers retry around a
+  // write, so neither may run where it preempts a writer of that slot
+  // (e.g. in an interrupt). Bulk slots are not covered.
+  result publish(slot_t slotId, const void *data, length_t size) noexcept
+  {
+    const uint8_t i = findSlot(slotId);
+    if ((i == NoSlot) || (data == nullptr) || (size != m_clientSlots[i].size))
+    {
+      return result::errFault;
+    }
+    const uint32_t seq = writeBegin(i);
+    copySlot(m_clientSlots[i].data, data, size);
+    writeEnd(i, seq, false);
+    return result::ok;
+  }
+
+  result snapshot(slot_t slotId, void *out, length_t size) const noexcept
+  {
+    const uint8_t i = findSlot(slotId);
+    if ((i == NoSlot) || (out == nullptr) || (size != m_clientSlots[i].size))
+    {
+      return result::errFault;
+    }
+    readSlot(i, out);
+    return result::ok;
+  }
+
+  template<typename T>
+  result publish(TypedSlot<T, Format> slot, const T &value) noexcept
+  {
+    if (!slot.valid() || (slot.index >= m_numSlots))
+    {
+      return result::errFault;
+    }
+    return publish(m_clientSlots[slot.index].slotId, &value,
+                   static_cast<length_t>(sizeof(T)));
+  }
+
+  template<typename T>
+  result snapshot(TypedSlot<T, Format> slot, T &value) const noexcept
+  {
+    if (!slot.valid() || (slot.index >= m_numSlots))
+    {
+      return result::errFault;
+    }
+    return snapshot(m_clientSlots[slot.index].slotId, &value,
+                    static_cast<length_t>(sizeof(T)));
+  }
+#endif
+
+  // Enable delta GET responses for a slot; 'reference' is an application
+  // buffer of the slot's size holding the last value sent to a client
+  result enableDelta(slot_t slotId, void *reference) noexcept
+  {
+    const uint8_t i = findSlot(slotId);
+    if (i == NoSlot)
+    {
+      return result::errFault;
+    }
+    if (reference == nullptr)
+    {
+      return result::errFault;
+    }
+    m_clientSlots[i].reference = reference;
+    m_clientSlots[i].refValid = false;
+    return result::ok;
+  }
+
+  // ---- Dirty tracking ------------------------------------------------------
+  // A slot is dirty from the moment its data changes until it is pushed to
+  // subscribers (notify/poll) or cleared by the application.
+  result markDirty(slot_t slotId) noexcept
+  {
+    const uint8_t i = findSlot(slotId);
+    if (i == NoSlot)
+    {
+      return result::errFault;
+    }
+    slotChanged(i);
+    refreshHash(i, slotHash(i));
+    return result::ok;
+  }
+
+  void clearDirty(slot_t slotId) noexcept
+  {
+    const uint8_t i = findSlot(slotId);
+    if (i != NoSlot)
+    {
+      clearDirtyIndex(i);
+    }
+  }
+
+  bool isDirty(slot_t slotId) const noexcept
+  {
+    const uint8_t i = findSlot(slotId);
+    return (i != NoSlot) && ((m_dirty[i >> 5] & (1U << (i & 31U))) != 0U);
+  }
+
+  // Find slots the application changed without markDirty() by comparing a
+  // CRC16 of each slot with the one taken when it was last seen; returns
+  // the number of slots newly marked dirty. Slots the bus wrote since the
+  // last scan only have their hash refreshed, so an application change
+  // made between such a write and the scan is attributed to the write.
+  uint8_t detectChanges() noexcept
+  {
+    uint8_t changed = 0U;
+    for (uint8_t i = 0U; i < m_numSlots; ++i)
+    {
+      const uint16_t hash = slotHash(i);
+      const bool stale = (m_stale[i >> 5] & (1U << (i & 31U))) != 0U;
+      if (!stale && (hash != m_clientSlots[i].hash))
+      {
+        slotChanged(i);
+        ++changed;
+      }
+      refreshHash(i, hash);
+    }
+    return changed;
+  }
+
+  // Call fn(slotId) for every dirty slot, in O(dirty) via bit scan
+  template<typename F>
+  void forEachDirty(F &&fn) const noexcept
+  {
+    scanDirty([&](uint8_t i)
+    {
+      fn(m_clientSlots[i].slotId);
+    });
+  }
+
+  // Publishing; call with a monotonic tick (wrap-around safe). Dirty slots
+  // with subscribers are pushed and cleared, then periodic ones are sent.
+  void poll(uint32_t now) noexcept
+  {
+    m_now = now;
+    for (uint8_t i = 0U; i < m_numSlots; ++i)
+    {
+      syncSlot(i);
+    }
+    scanDirty([&](uint8_t i)
+    {
+      if ((m_clientSlots[i].subscribers != 0U) && txReady())
+      {
+        clearDirtyIndex(i);
+        replySlot(i);
+      }
+    });
+
+    for (uint8_t i = 0U; i < m_numSlots; ++i)
+    {
+      clientSlot_t<Format> &slot = m_clientSlots[i];
+      if ((slot.subscribers != 0U) && (slot.period != 0U)
+          && ((now - slot.lastPublish) >= slot.period) && txReady())
+      {
+        slot.lastPublish = now;
+        replySlot(i);
+      }
+    }
+  }
+
+  // Incoming data (GetReq / SetReq)
+  result inputData(const uint8_t *data, length_t size) noexcept
+  {
+    if (size < static_cast<length_t>(HeaderSize + 2U))
+    {
+      return result::errFault;
+    }
+    if (!checkCRC16(data, size))
+    {
+      return result::errCrc;
+    }
+
+    const uint32_t serverId = read_le32(&data[FrameServerId]);
+    if (serverId != m_serverId)
+    {
+      // Not for this server; ignore silently or return a benign code.
+      return result::ok;
+    }
+
+    const slot_t slotId = Format::readField(&data[FrameSlotId]);
+    const auto function = static_cast<SyncBusFunc>(data[FrameFunction]
+        & static_cast<uint8_t>(~FuncFlagTid));
+
+    const bool tagged = (data[FrameFunction] & FuncFlagTid) != 0U;
+    const uint8_t dataAt = tagged ? (FrameData + TidSize) : FrameData;
+    if (size < static_cast<length_t>(dataAt + 2U))
+    {
+      return result::errFault;
+    }
+    const length_t payloadLen = static_cast<length_t>(size - dataAt - 2U);
+
+    const result res = dispatch(slotId, function, &data[dataAt], payloadLen,
+                                tagged ? data[HeaderSize] : NoTid);
+    m_tid = NoTid;
+    return res;
+  }
+
+  // Register a typed (slotId, data*); size is sizeof(T)
+  template<typename T>
+  TypedSlot<T, Format> addSlot(T *data, slot_t slotId) noexcept
+  {
+    const uint8_t index = m_numSlots;
+    if (addSlot(static_cast<void*>(data), slotId,
+                static_cast<length_t>(sizeof(T))) != result::ok)
+    {
+      return TypedSlot<T, Format> { NoSlot };
+    }
+    return TypedSlot<T, Format> { index };
+  }
+
+  // Register a (slotId, size, data*)
+  result addSlot(void *data, slot_t slotId, length_t size) noexcept
+  {
+    if (data == nullptr)
+    {
+      return result::errFault;
+    }
+    if (m_numSlots >= numSlots)
+    {
+      return result::errOverflow;
+    }
+
+    // enforce maximum payload per frame for GET response
+    if ((static_cast<uint16_t>(HeaderSize) + size + 2U) > BufferSize)
+    {
+      return result::errOverflow;
+    }
+    if (findSlot(slotId) != NoSlot)
+    {
+      return result::errDuplicate;
+    }
+
+    m_clientSlots[m_numSlots].data = data;
+    m_clientSlots[m_numSlots].slotId = slotId;
+    m_clientSlots[m_numSlots].size = size;
+    m_clientSlots[m_numSlots].subscribers = 0U;
+    m_clientSlots[m_numSlots].period = 0U;
+    m_clientSlots[m_numSlots].lastPublish = 0U;
+    m_clientSlots[m_numSlots].hash = slotHash(m_numSlots);
+    m_clientSlots[m_numSlots].version = 0U;
+    m_clientSlots[m_numSlots].reference = nullptr;
+    m_clientSlots[m_numSlots].refVersion = 0U;
+    m_clientSlots[m_numSlots].refValid = false;
+
+    if (DirectIndex)
+    {
+      m_slotIndex[slotId] = m_numSlots;
+    } else
+    {
+      // insertion into the slotId-ordered index
+      uint8_t pos = m_numSlots;
+      while ((pos > 0U)
+          && (m_clientSlots[m_slotIndex[pos - 1U]].slotId > slotId))
+      {
+        m_slotIndex[pos] = m_slotIndex[pos - 1U];
+        --pos;
+      }
+      m_slotIndex[pos] = m_numSlots;
+    }
+    ++m_numSlots;
+
+    return result::ok;
+  }
+
+  // Register a bulk slot (up to 64 KiB, moved in fragments); 'staging'
+  // (optional, 'size' bytes) collects an incoming SET so 'data' changes
+  // only when the transfer completes
+  result addBulkSlot(void *data, slot_t slotId, uint16_t size,
+      void *staging = nullptr) noexcept
+  {
+    if ((data == nullptr) || (size == 0U))
+    {
+      return result::errFault;
+    }
+    if (m_numBulk >= numBulk)
+    {
+      return result::errOverflow;
+    }
+    if (findBulk(slotId) != NoSlot)
+    {
+      return result::errDuplicate;
+    }
+
+    m_bulk[m_numBulk].data = data;
+    m_bulk[m_numBulk].staging = staging;
+    m_bulk[m_numBulk].slotId = slotId;
+    m_bulk[m_numBulk].size = size;
+    m_bulk[m_numBulk].next = 0U;
+    ++m_numBulk;
+
+    return result::ok;
+  }
+
+private:
+  using frameTx_t<Format, Hooks>::m_hooks;
+  using frameTx_t<Format, Hooks>::m_buffer;
+  using frameTx_t<Format, Hooks>::transmit;
+  using frameTx_t<Format, Hooks>::txReady;
+  using bulkStore_t<bulkSlot_t<Format>, numBulk>::m_bulk;
+
+  // Handle one request; 'payload' follows the header and the TID, if any
+  result dispatch(slot_t slotId, SyncBusFunc function, const uint8_t *payload,
+      length_t payloadLen, uint16_t tid) noexcept
+  {
+    if (function == SyncBusFunc::GetMultiReq)
+    {
+      // FrameSlotId carries the number of requested slotIds
+      if (payloadLen != (slotId * sizeof(slot_t)))
+      {
+        return result::errFault;
+      }
+      return replyMulti(payload, slotId);
+    }
+
+    if (function == SyncBusFunc::SetMultiReq)
+    {
+      // FrameSlotId carries the record count
+      return applyMulti(payload, payloadLen, slotId);
+    }
+
+    if ((function == SyncBusFunc::BulkGetReq)
+        || (function == SyncBusFunc::BulkSetReq))
+    {
+      return bulkInput(slotId, function, payload, payloadLen);
+    }
+
+    const uint8_t i = findSlot(slotId);
+    if (i == NoSlot)
+    {
+      // Unknown slot; ignore
+      return result::ok;
+    }
+
+    // Single-slot replies echo the TID when it fits next to the largest of
+    // them (GetVerResp); otherwise they go out untagged
+    if ((static_cast<uint16_t>(HeaderSize) + TidSize + VersionSize
+        + m_clientSlots[i].size + 2U) <= BufferSize)
+    {
+      m_tid = tid;
+    }
+    syncSlot(i);
+
+    if (function == SyncBusFunc::GetReq)
+    {
+      return replySlot(i);
+    } else if (function == SyncBusFunc::GetIfModReq)
+    {
+      if ((payloadLen == VersionSize)
+          && (read_le16(payload) == m_clientSlots[i].version))
+      {
+        uint8_t version[VersionSize];
+        write_le16(version, m_clientSlots[i].version);
+        transmit(buildFrame<Format>(m_buffer, m_serverId, slotId,
+                                    SyncBusFunc::NotModified, version,
+                                    VersionSize, m_tid));
+        return result::ok;
+      }
+      return replyVersioned(i);
+    } else if (function == SyncBusFunc::GetDeltaReq)
+    {
+      return replyDelta(i, payload, payloadLen);
+    } else if (function == SyncBusFunc::SetDeltaReq)
+    {
+      return applyDeltaSet(i, payload, payloadLen);
+    } else if (function == SyncBusFunc::Subscribe)
+    {
+      // No client addressing on the bus: subscribers are counted, and
+      // notifications go out as GetResp frames every client can match.
+      clientSlot_t<Format> &slot = m_clientSlots[i];
+      if (slot.subscribers < 0xFFU)
+      {
+        ++slot.subscribers;
+      }
+      if (payloadLen == 2U)
+      {
+        slot.period = read_le16(payload);
+      }
+      slot.lastPublish = m_now;
+      // initial value
+      return replySlot(i);
+    } else if (function == SyncBusFunc::Unsubscribe)
+    {
+      clientSlot_t<Format> &slot = m_clientSlots[i];
+      if (slot.subscribers > 0U)
+      {
+        --slot.subscribers;
+      }
+      if (slot.subscribers == 0U)
+      {
+        slot.period = 0U;
+      }
+    } else if (function == SyncBusFunc::SetReq)
+    {
+      // Validate payload size
+      if (payloadLen != m_clientSlots[i].size)
+      {
+        return result::errFault;
+      }
+
+      writeSlot(i, payload);
+      slotChanged(i);
+      m_hooks.changed(m_serverId, slotId, i);
+
+#if !SYNCBUS_ENABLE_SET_ACK
+      // Tagged SETs are always acknowledged so the client can complete them
+      if (m_tid == NoTid)
+      {
+        return result::ok;
+      }
+#endif
+      // Send SetResp ACK (no payload)
+      if ((static_cast<uint16_t>(HeaderSize) + 2U) > BufferSize)
+      {
+        return result::errOverflow;
+      }
+      length_t ackSize = buildFrame<Format>(m_buffer, m_serverId, slotId,
+                                            SyncBusFunc::SetResp, nullptr, 0U,
+                                            m_tid);
+      transmit(ackSize);
+    }
+
+    return result::ok;
+  }
+
+  // BulkGetReq: send up to 'window' fragments from 'offset', flagging the
+  // last one. BulkSetReq: store fragments arriving in order and acknowledge
+  // the window end (or completion) with the in-order byte count.
+  result bulkInput(slot_t slotId, SyncBusFunc function,
+      const uint8_t *payload, length_t payloadLen) noexcept
+  {
+    const uint8_t b = findBulk(slotId);
+    if (b == NoSlot)
+    {
+      return result::ok;
+    }
+    bulkSlot_t<Format> &slot = m_bulk[b];
+
+    if (function == SyncBusFunc::BulkGetReq)
+    {
+      if (payloadLen != 3U)
+      {
+        return result::errFault;
+      }
+      uint16_t offset = read_le16(payload);
+      const uint8_t window = payload[2];
+      for (uint8_t n = 0U; (n < window) && (offset < slot.size); ++n)
+      {
+        const uint16_t left = static_cast<uint16_t>(slot.size - offset);
+        const length_t len = (left < FragPayloadMax) ? static_cast<length_t>(left)
+                                                     : FragPayloadMax;
+        const bool last = ((n + 1U) == window) || ((offset + len) == slot.size);
+        transmit(writeFragmentHeader<Format>(m_buffer, m_serverId, slotId,
+                                             SyncBusFunc::BulkGetResp,
+                                             slot.size, offset,
+                                             last ? FragFlagWindowEnd : 0U),
+                 static_cast<const uint8_t*>(slot.data) + offset, len);
+        offset = static_cast<uint16_t>(offset + len);
+      }
+      return result::ok;
+    }
+
+    if (payloadLen < FragHeaderSize)
+    {
+      return result::errFault;
+    }
+    const uint16_t offset = read_le16(payload);
+    const length_t len = static_cast<length_t>(payloadLen - FragHeaderSize);
+    if ((read_le16(&payload[2]) != slot.size) || ((offset + len) > slot.size))
+    {
+      return result::errFault;
+    }
+
+    if (offset == 0U)
+    {
+      slot.next = 0U;  // (re)start of a transfer
+    }
+    const bool complete = (offset == slot.next) && ((offset + len) == slot.size);
+    if (offset == slot.next)
+    {
+      void *dst = (slot.staging != nullptr) ? slot.staging : slot.data;
+      std::memcpy(static_cast<uint8_t*>(dst) + offset, &payload[FragHeaderSize],
+                  len);
+      slot.next = static_cast<uint16_t>(slot.next + len);
+    }
+
+    if (complete)
+    {
+      if (slot.staging != nullptr)
+      {
+        std::memcpy(slot.data, slot.staging, slot.size);
+      }
+      m_hooks.changed(m_serverId, slotId, b);
+    }
+    if (complete || ((payload[4] & FragFlagWindowEnd) != 0U))
+    {
+      uint8_t ack[2];
+      write_le16(ack, slot.next);
+      transmit(buildFrame<Format>(m_buffer, m_serverId, slotId,
+                                  SyncBusFunc::BulkSetResp, ack, sizeof(ack)));
+    }
+    return result::ok;
+  }
+
+  uint8_t findBulk(slot_t slotId) const noexcept
+  {
+    for (uint8_t b = 0U; b < m_numBulk; ++b)
+    {
+      if (m_bulk[b].slotId == slotId)
+      {
+        return b;
+      }
+    }
+    return NoSlot;
+  }
+
+  // GetResp payload for one slot; 'copy' (optional) receives the value sent
+  result replySlot(uint8_t i, void *copy = nullptr) noexcept
+  {
+    const length_t payload = m_clientSlots[i].size;
+    if ((static_cast<uint16_t>(HeaderSize) + payload + 2U) > BufferSize)
+    {
+      return result::errOverflow;
+    }
+    transmitSlot(writeHeader<Format>(m_buffer, m_serverId,
+                                     m_clientSlots[i].slotId,
+                                     SyncBusFunc::GetResp, m_tid), i, copy);
+    return result::ok;
+  }
+
+  // GetVerResp: version + slot data. A slot too large to carry the version
+  // is answered with a plain GetResp (the client then drops its version).
+  // 'copy' (optional) receives the value sent.
+  result replyVersioned(uint8_t i, void *copy = nullptr) noexcept
+  {
+    const clientSlot_t<Format> &slot = m_clientSlots[i];
+    if ((static_cast<uint16_t>(HeaderSize) + VersionSize + slot.size + 2U)
+        > BufferSize)
+    {
+      return replySlot(i, copy);
+    }
+
+    const length_t len = writeHeader<Format>(m_buffer, m_serverId,
+                                             slot.slotId,
+                                             SyncBusFunc::GetVerResp, m_tid);
+    write_le16(&m_buffer[len], slot.version);
+    transmitSlot(static_cast<length_t>(len + VersionSize), i, copy);
+    return result::ok;
+  }
+
+  // 'head' bytes in m_buffer followed by slot i. With
+  // SYNCBUS_ENABLE_SEQLOCK the slot is copied into the frame under its
+  // seqlock; 'copy' (optional) receives the value sent.
+  void transmitSlot(length_t head, uint8_t i, void *copy = nullptr) noexcept
+  {
+    const clientSlot_t<Format> &slot = m_clientSlots[i];
+#if SYNCBUS_ENABLE_SEQLOCK
+    Crc16State crc;
+    uint32_t seq;
+    do
+    {
+      seq = readBegin(i);
+      crc.reset();
+      crc.update(m_buffer, head);
+      crc.copy(&m_buffer[head], slot.data, slot.size);
+    } while (readRetry(i, seq));
+    if (copy != nullptr)
+    {
+      std::memcpy(copy, &m_buffer[head], slot.size);
+    }
+    transmit(putCRC16(m_buffer, static_cast<length_t>(head + slot.size),
+                      crc.finalize()));
+#else
+    if (copy != nullptr)
+    {
+      std::memcpy(copy, slot.data, slot.size);
+    }
+    transmit(head, slot.data, slot.size);
+#endif
+  }
+
+  // Answer a GetDeltaReq: NotModified, patches against the reference when
+  // the client holds it and they are smaller, otherwise GetVerResp
+  result replyDelta(uint8_t i, const uint8_t *payload,
+      length_t payloadLen) noexcept
+  {
+    clientSlot_t<Format> &slot = m_clientSlots[i];
+    const bool hasVersion = (payloadLen == VersionSize);
+    const uint16_t clientVersion = hasVersion ? read_le16(payload) : 0U;
+
+    if (hasVersion && (clientVersion == slot.version))
+    {
+      uint8_t version[VersionSize];
+      write_le16(version, slot.version);
+      transmit(buildFrame<Format>(m_buffer, m_serverId, slot.slotId,
+                                  SyncBusFunc::NotModified, version,
+                                  VersionSize, m_tid));
+      return result::ok;
+    }
+
+    const uint8_t len = writeHeader<Format>(m_buffer, m_serverId, slot.slotId,
+                                            SyncBusFunc::DeltaResp, m_tid);
+    const length_t prefix = static_cast<length_t>(len + 2U * VersionSize);
+    // patches must beat GetVerResp, which carries one version less, and
+    // leave room for the CRC (encodeDelta stays below 'limit')
+    const length_t limit = ((prefix + slot.size - VersionSize + 2U)
+        <= BufferSize) ? static_cast<length_t>(slot.size - VersionSize)
+                       : static_cast<length_t>(BufferSize - prefix - 1U);
+    length_t patchLen = 0U;
+    bool delta;
+    uint32_t seq;
+    do
+    {
+      seq = readBegin(i);
+      delta = hasVersion && (slot.reference != nullptr) && slot.refValid
+          && (clientVersion == slot.refVersion) && (slot.size > VersionSize)
+          && encodeDelta<Format>(&m_buffer[prefix], patchLen,
+                                 static_cast<const uint8_t*>(slot.reference),
+                                 static_cast<const uint8_t*>(slot.data),
+                                 slot.size, limit);
+    } while (readRetry(i, seq));
+
+    // The reference becomes the value sent
+    if (delta)
+    {
+      write_le16(&m_buffer[len], slot.refVersion);
+      write_le16(&m_buffer[len + VersionSize], slot.version);
+      applyDelta<Format>(static_cast<uint8_t*>(slot.reference), slot.size,
+                         &m_buffer[prefix], patchLen);
+      transmit(genCRC16(m_buffer, static_cast<length_t>(prefix + patchLen)));
+    } else
+    {
+      replyVersioned(i, slot.reference);
+    }
+
+    if (slot.reference != nullptr)
+    {
+      slot.refVersion = slot.version;
+      slot.refValid = true;
+    }
+    return result::ok;
+  }
+
+  // Apply a SetDeltaReq. Patches are only valid against the version they
+  // were computed from; otherwise the client is told to resend in full.
+  result applyDeltaSet(uint8_t i, const uint8_t *payload,
+      length_t payloadLen) noexcept
+  {
+    constexpr uint8_t Prefix = 1U + VersionSize;
+    if (payloadLen < Prefix)
+    {
+      return result::errFault;
+    }
+
+    clientSlot_t<Format> &slot = m_clientSlots[i];
+    const uint8_t flags = payload[0];
+    const uint8_t *body = &payload[Prefix];
+    const length_t bodyLen = static_cast<length_t>(payloadLen - Prefix);
+    uint8_t status[1U + VersionSize];
+
+    const bool full = (flags & DeltaFlagFull) != 0U;
+    if (full && (bodyLen != slot.size))
+    {
+      return result::errFault;
+    }
+    if (!full && (read_le16(&payload[1U]) != slot.version))
+    {
+      status[0] = 0U;
+      write_le16(&status[1], slot.version);
+      transmit(buildFrame<Format>(m_buffer, m_serverId, slot.slotId,
+                                  SyncBusFunc::SetDeltaResp, status,
+                                  sizeof(status), m_tid));
+      return result::ok;
+    }
+
+    // The reference takes the value written, inside the same write
+    const uint32_t seq = writeBegin(i);
+    bool applied = true;
+    if (full)
+    {
+      copySlot(slot.data, body, bodyLen);
+    } else
+    {
+      applied = applyDelta<Format>(static_cast<uint8_t*>(slot.data), slot.size,
+                                   body, bodyLen);
+    }
+    if (applied && (slot.reference != nullptr))
+    {
+      std::memcpy(slot.reference, slot.data, slot.size);
+    }
+    writeEnd(i, seq, applied);
+    if (!applied)
+    {
+      return result::errFault;
+    }
+
+    slotChanged(i);
+    if (slot.reference != nullptr)
+    {
+      slot.refVersion = slot.version;
+      slot.refValid = true;
+    }
+    m_hooks.changed(m_serverId, slot.slotId, i);
+
+    status[0] = 1U;
+    write_le16(&status[1], slot.version);
+    transmit(buildFrame<Format>(m_buffer, m_serverId, slot.slotId,
+                                SyncBusFunc::SetDeltaResp, status,
+                                sizeof(status), m_tid));
+    return result::ok;
+  }
+
+  // Pack the requested slots into as few GetMultiResp frames as fit in
+  // BufferSize. Unknown slotIds are skipped; a slot too large for a
+  // record is answered with a plain GetResp.
+  result replyMulti(const uint8_t *ids, length_t count) noexcept
+  {
+    length_t len = HeaderSize;
+    length_t records = 0U;
+
+    for (length_t n = 0U; n < count; ++n)
+    {
+      const slot_t id = Format::readField(&ids[n * sizeof(slot_t)]);
+      const uint8_t i = findSlot(id);
+      if (i == NoSlot)
+      {
+        continue;
+      }
+
+      const length_t payload = m_clientSlots[i].size;
+      const uint32_t recSize = static_cast<uint32_t>(RecordHeaderSize)
+          + payload;
+      const bool oversize = (static_cast<uint16_t>(HeaderSize) + recSize + 2U)
+          > BufferSize;
+      if ((records > 0U) && (oversize || ((len + recSize + 2U)
+          > BufferSize)))
+      {
+        flushMulti(len, records);
+        len = HeaderSize;
+        records = 0U;
+      }
+      if (oversize)
+      {
+        replySlot(i);
+        continue;
+      }
+
+      Format::writeField(&m_buffer[len], id);
+      Format::writeField(&m_buffer[len + sizeof(slot_t)], payload);
+      len = static_cast<length_t>(len + RecordHeaderSize);
+      readSlot(i, &m_buffer[len]);
+      len = static_cast<length_t>(len + payload);
+      ++records;
+    }
+
+    if (records > 0U)
+    {
+      flushMulti(len, records);
+    }
+    return result::ok;
+  }
+
+  void flushMulti(length_t len, length_t records) noexcept
+  {
+    writeHeader<Format>(m_buffer, m_serverId, records,
+                        SyncBusFunc::GetMultiResp);
+    transmit(genCRC16(m_buffer, len));
+  }
+
+  // Apply a SetMultiReq as a unit: the whole frame is validated first, every
+  // valid record is then copied, and only after the batch are the change
+  // callbacks fired. One SetMultiResp reports per-record status.
+  result applyMulti(const uint8_t *recs, length_t len, length_t count) noexcept
+  {
+    // bit r: record r applied. 'count' comes off the wire and inputData
+    // takes frames longer than BufferSize: more records than the payload
+    // can hold, or than MaxRecords, is a malformed frame.
+    if ((count > MaxRecords) || (count > (len / RecordHeaderSize)))
+    {
+      return result::errFault;
+    }
+    uint8_t status[(MaxRecords + 7U) / 8U] = { };
+    length_t off = 0U;
+
+    for (length_t r = 0U; r < count; ++r)
+    {
+      if ((off + RecordHeaderSize) > len)
+      {
+        return result::errFault;
+      }
+      const length_t recLen = Format::readField(&recs[off + sizeof(slot_t)]);
+      if ((off + RecordHeaderSize + recLen) > len)
+      {
+        return result::errFault;
+      }
+      const uint8_t i = findSlot(Format::readField(&recs[off]));
+      if ((i != NoSlot) && (recLen == m_clientSlots[i].size))
+      {
+        status[r >> 3] = static_cast<uint8_t>(status[r >> 3] | (1U << (r & 7U)));
+      }
+      off = static_cast<length_t>(off + RecordHeaderSize + recLen);
+    }
+    if (off != len)
+    {
+      return result::errFault;
+    }
+
+    off = 0U;
+    for (length_t r = 0U; r < count; ++r)
+    {
+      const length_t recLen = Format::readField(&recs[off + sizeof(slot_t)]);
+      if ((status[r >> 3] & (1U << (r & 7U))) != 0U)
+      {
+        const uint8_t i = findSlot(Format::readField(&recs[off]));
+        writeSlot(i, &recs[off + RecordHeaderSize]);
+        slotChanged(i);
+      }
+      off = static_cast<length_t>(off + RecordHeaderSize + recLen);
+    }
+
+    off = 0U;
+    for (length_t r = 0U; r < count; ++r)
+    {
+      if ((status[r >> 3] & (1U << (r & 7U))) != 0U)
+      {
+        const slot_t id = Format::readField(&recs[off]);
+        m_hooks.changed(m_serverId, id, findSlot(id));
+      }
+      off = static_cast<length_t>(off + RecordHeaderSize
+          + Format::readField(&recs[off + sizeof(slot_t)]));
+    }
+
+#if SYNCBUS_ENABLE_SET_ACK
+    const length_t statusLen = static_cast<length_t>((count + 7U) / 8U);
+    if ((static_cast<uint16_t>(HeaderSize) + statusLen + 2U) > BufferSize)
+    {
+      return result::errOverflow;
+    }
+    transmit(buildFrame<Format>(m_buffer, m_serverId, count,
+                                SyncBusFunc::SetMultiResp, status, statusLen));
+#endif
+    return result::ok;
+  }
+
+  uint16_t slotHash(uint8_t i) const noexcept
+  {
+    uint16_t hash;
+    uint32_t seq;
+    do
+    {
+      seq = readBegin(i);
+      hash = crc16Update(Crc16Init,
+          static_cast<const uint8_t*>(m_clientSlots[i].data),
+          m_clientSlots[i].size);
+    } while (readRetry(i, seq));
+    return hash;
+  }
+
+  // ---- Seqlock -------------------------------------------------------------
+  // A slot's sequence is odd while a writer copies into it. Readers copy
+  // between readBegin() and readRetry() and start over if a write overlapped;
+  // writers take the odd value by CAS, so they also exclude each other.
+  // Without SYNCBUS_ENABLE_SEQLOCK these are plain accesses.
+  uint32_t readBegin(uint8_t i) const noexcept
+  {
+#if SYNCBUS_ENABLE_SEQLOCK
+    uint32_t seq = m_seq[i].load(std::memory_order_acquire);
+    while ((seq & 1U) != 0U)
+    {
+      seq = m_seq[i].load(std::memory_order_acquire);
+    }
+    return seq;
+#else
+    static_cast<void>(i);
+    return 0U;
+#endif
+  }
+
+  bool readRetry(uint8_t i, uint32_t seq) const noexcept
+  {
+#if SYNCBUS_ENABLE_SEQLOCK
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return m_seq[i].load(std::memory_order_relaxed) != seq;
+#else
+    static_cast<void>(i);
+    static_cast<void>(seq);
+    return false;
+#endif
+  }
+
+  uint32_t writeBegin(uint8_t i) noexcept
+  {
+#if SYNCBUS_ENABLE_SEQLOCK
+    uint32_t seq = m_seq[i].load(std::memory_order_relaxed);
+    while (((seq & 1U) != 0U)
+        || !m_seq[i].compare_exchange_weak(seq, seq + 1U,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed))
+    {
+      seq = m_seq[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return seq;
+#else
+    static_cast<void>(i);
+    return 0U;
+#endif
+  }
 
-    const uint8_t slotId = data[FrameSlotId];
-    const auto function = static_cast<SyncBusFunc>(data[FrameFunction]);
-    const uint8_t payloadLen = static_cast<uint8_t>(size - HeaderSize - 2U);
+  // 'own': a bus thread write the caller accounts for with slotChanged()
+  void writeEnd(uint8_t i, uint32_t seq, bool own) noexcept
+  {
+#if SYNCBUS_ENABLE_SEQLOCK
+    m_seq[i].store(seq + 2U, std::memory_order_release);
+    if (own)
+    {
+      m_seen[i] = seq + 2U;
+    }
+#else
+    static_cast<void>(i);
+    static_cast<void>(seq);
+    static_cast<void>(own);
+#endif
+  }
 
-    if (function == SyncBusFunc::GetReq)
+  void readSlot(uint8_t i, void *dst) const noexcept
+  {
+    uint32_t seq;
+    do
+    {
+      seq = readBegin(i);
+      copySlot(dst, m_clientSlots[i].data, m_clientSlots[i].size);
+    } while (readRetry(i, seq));
+  }
+
+  void writeSlot(uint8_t i, const void *src) noexcept
+  {
+    const uint32_t seq = writeBegin(i);
+    copySlot(m_clientSlots[i].data, src, m_clientSlots[i].size);
+    writeEnd(i, seq, true);
+  }
+
+  // Take a value published since the last look as a change
+  void syncSlot(uint8_t i) noexcept
+  {
+#if SYNCBUS_ENABLE_SEQLOCK
+    const uint32_t seq = m_seq[i].load(std::memory_order_acquire);
+    if (((seq & 1U) == 0U) && (seq != m_seen[i]))
+    {
+      m_seen[i] = seq;
+      slotChanged(i);
+    }
+#else
+    static_cast<void>(i);
+#endif
+  }
+
+  // Slot data changed: new version, dirty. The hash is left stale for
+  // detectChanges() to refresh instead of checksumming every bus write.
+  void slotChanged(uint8_t i) noexcept
+  {
+    ++m_clientSlots[i].version;
+    markDirtyIndex(i);
+    m_stale[i >> 5] |= 1U << (i & 31U);
+  }
+
+  void refreshHash(uint8_t i, uint16_t hash) noexcept
+  {
+    m_clientSlots[i].hash = hash;
+    m_stale[i >> 5] &= ~(1U << (i & 31U));
+  }
+
+  void markDirtyIndex(uint8_t i) noexcept
+  {
+    m_dirty[i >> 5] |= 1U << (i & 31U);
+  }
+
+  void clearDirtyIndex(uint8_t i) noexcept
+  {
+    m_dirty[i >> 5] &= ~(1U << (i & 31U));
+  }
+
+  // fn(index) for each dirty bit set when the scan reaches its word
+  template<typename F>
+  void scanDirty(F &&fn) const
+  {
+    for (uint8_t w = 0U; w < DirtyWords; ++w)
     {
-      for (uint8_t i = 0U; i < m_numSlots; ++i)
+      uint32_t bits = m_dirty[w];
+      while (bits != 0U)
       {
-        if (m_clientSlots[i].slotId == slotId)
-        {
-          const uint8_t payload = m_clientSlots[i].size;
-          const uint16_t totalNoCrc = static_cast<uint16_t>(HeaderSize)
-              + payload;
+        fn(static_cast<uint8_t>((w << 5) + lowestBit(bits)));
+        bits &= bits - 1U;
+      }
+    }
+  }
 
-          if (totalNoCrc + 2U > SYNCBUS_BUFFER_SIZE)
-          {
-            return result::errOverflow;
-          }
+  void initIndex() noexcept
+  {
+    if (DirectIndex)
+    {
+      std::memset(m_slotIndex, NoSlot, sizeof(m_slotIndex));
+    }
+  }
 
-          write_le32(&m_buffer[FrameServerId], m_serverId);
-          m_buffer[FrameSlotId] = slotId;
-          m_buffer[FrameFunction] = static_cast<uint8_t>(SyncBusFunc::GetResp);
-          std::memcpy(&m_buffer[FrameData], m_clientSlots[i].data, payload);
+  // Index into m_clientSlots for 'slotId', or NoSlot
+  uint8_t findSlot(slot_t slotId) const noexcept
+  {
+    if (DirectIndex)
+    {
+      return m_slotIndex[slotId];
+    }
 
-          uint8_t responseSize = genCRC16(m_buffer,
-                                          static_cast<uint8_t>(totalNoCrc));
-          if (m_sendData_cb != nullptr)
-          {
-            m_sendData_cb(m_buffer, responseSize);
-          }
-          break;
-        }
+    uint8_t lo = 0U;
+    uint8_t hi = m_numSlots;
+    while (lo < hi)
+    {
+      const uint8_t mid = static_cast<uint8_t>((lo + hi) / 2U);
+      const uint8_t idx = m_slotIndex[mid];
+      if (m_clientSlots[idx].slotId == slotId)
+      {
+        return idx;
       }
-    } else if (function == SyncBusFunc::SetReq)
+      if (m_clientSlots[idx].slotId < slotId)
+      {
+        lo = static_cast<uint8_t>(mid + 1U);
+      } else
+      {
+        hi = mid;
+      }
+    }
+    return NoSlot;
+  }
+
+  // Wire layout of the selected Format (hides the CompactFrame constants)
+  static constexpr uint8_t FrameSlotId = Format::FrameSlotId;
+  static constexpr uint8_t FrameFunction = Format::FrameFunction;
+  static constexpr uint8_t FrameData = Format::FrameData;
+  static constexpr uint8_t HeaderSize = Format::HeaderSize;
+  static constexpr uint8_t RecordHeaderSize = Format::RecordHeaderSize;
+  static constexpr size_t BufferSize = Format::BufferSize;
+  static constexpr length_t FragPayloadMax = Format::FragPayloadMax;
+  static constexpr size_t MaxRecords = BufferSize / RecordHeaderSize;
+
+  // 16-bit slotIds always use the sorted index
+  static constexpr bool DirectIndex = (SYNCBUS_SLOT_INDEX
+      == SYNCBUS_SLOT_INDEX_DIRECT) && (sizeof(slot_t) == 1U);
+
+  static constexpr uint8_t DirtyWords = static_cast<uint8_t>((numSlots + 31U)
+      / 32U);
+
+  uint32_t m_serverId;
+  uint8_t m_numSlots;
+  clientSlot_t<Format> m_clientSlots[numSlots];
+  uint8_t m_numBulk;
+  uint32_t m_dirty[DirtyWords];  // bit i: m_clientSlots[i] dirty
+  uint32_t m_stale[DirtyWords];  // bit i: m_clientSlots[i].hash predates a write
+  // DirectIndex: slotId -> index into m_clientSlots; otherwise indices into
+  // m_clientSlots ordered by slotId
+  uint8_t m_slotIndex[DirectIndex ? 256U : numSlots];
+  uint32_t m_now;  // last tick passed to poll()
+  uint16_t m_tid;  // TID echoed by replies to the request in hand, or NoTid
+#if SYNCBUS_ENABLE_SEQLOCK
+  std::atomic<uint32_t> m_seq[numSlots];  // per-slot seqlock sequence
+  uint32_t m_seen[numSlots];  // sequence whose change the bus thread took
+#endif
+};
+
+// ============================================================================
+//                                DEFRAMER
+// ============================================================================
+// Byte-stream framing for UART/TCP links, where reads return arbitrary
+// chunks. Each SyncBus frame is sent as
+//
+//   [0x7E SOF][LEN][frame (LEN bytes, CRC included)]
+//
+// The receiver hunts for SOF, checks LEN against the valid frame range and
+// accepts the candidate only if its CRC matches; on a mismatch it re-hunts
+// from the byte after the false SOF, so garbage costs no more than a scan.
+// A noise 0x7E with a plausible LEN makes the receiver wait for LEN bytes;
+// the transport calls idle() when the link goes quiet so frames swallowed by
+// such a candidate are not held back until more traffic arrives.
+static constexpr uint8_t DeframeSof = 0x7EU;
+static constexpr uint8_t DeframePrefixSize = 2U;
+
+// Prefix to transmit in front of a frame of 'frameSize' bytes
+static inline uint8_t writeFramePrefix(uint8_t *dst, uint8_t frameSize) noexcept
+{
+  dst[0] = DeframeSof;
+  dst[1] = frameSize;
+  return DeframePrefixSize;
+}
+
+// Sink is a SyncBusClient/SyncBusServer (anything with inputData(ptr, len))
+template<typename Sink>
+class SyncBusDeframer
+{
+public:
+  explicit SyncBusDeframer(Sink &sink) noexcept :
+      m_sink(sink), m_fill(0U), m_crc()
+  {
+  }
+
+  // Drop any partially received frame
+  void reset() noexcept
+  {
+    m_fill = 0U;
+  }
+
+  // The link went quiet (read timeout, inter-frame gap): stop waiting for
+  // the pending candidate and re-hunt the bytes it buffered. Returns the
+  // number of frames delivered.
+  uint16_t idle() noexcept
+  {
+    if (m_fill == 0U)
+    {
+      return 0U;
+    }
+    return resync();
+  }
+
+  // Feed a received chunk; returns the number of frames delivered. Frames
+  // lying entirely inside 'data' are handed to the sink in place; only a
+  // frame split across chunks is assembled in the internal buffer.
+  uint16_t input(const uint8_t *data, size_t size) noexcept
+  {
+    uint16_t frames = 0U;
+    size_t pos = 0U;
+
+    while (pos < size)
     {
-      for (uint8_t i = 0U; i < m_numSlots; ++i)
+      if (m_fill == 0U)
       {
-        if (m_clientSlots[i].slotId == slotId)
+        const void *sof = std::memchr(&data[pos], DeframeSof, size - pos);
+        if (sof == nullptr)
         {
-          // Validate payload size
-          if (payloadLen != m_clientSlots[i].size)
-          {
-            return result::errFault;
-          }
+          break;
+        }
+        pos = static_cast<size_t>(static_cast<const uint8_t*>(sof) - data);
 
-          std::memcpy(m_clientSlots[i].data, &data[FrameData], payloadLen);
-          if (m_dataChanged_cb != nullptr)
+        const size_t avail = size - pos;
+        if (avail >= DeframePrefixSize)
+        {
+          const uint8_t len = data[pos + 1U];
+          if (!validLength(len))
           {
-            m_dataChanged_cb(slotId);
+            ++pos;
+            continue;
           }
-
-#if SYNCBUS_ENABLE_SET_ACK
-          // Send SetResp ACK (no payload)
-          if ((static_cast<uint16_t>(HeaderSize) + 2U) > SYNCBUS_BUFFER_SIZE)
+          if (avail >= static_cast<size_t>(DeframePrefixSize + len))
           {
-            return result::errOverflow;
+            const uint8_t *frame = &data[pos + DeframePrefixSize];
+            if (checkCRC16(frame, len))
+            {
+              m_sink.inputData(frame, len);
+              ++frames;
+              pos += DeframePrefixSize + len;
+            } else
+            {
+              ++pos;
+            }
+            continue;
           }
-          write_le32(&m_buffer[FrameServerId], m_serverId);
-          m_buffer[FrameSlotId] = slotId;
-          m_buffer[FrameFunction] = static_cast<uint8_t>(SyncBusFunc::SetResp);
+        }
+        // Candidate runs past the chunk: buffer it below
+      }
 
-          uint8_t ackSize = genCRC16(m_buffer, HeaderSize);
-          if (m_sendData_cb != nullptr)
+      if (m_fill < DeframePrefixSize)
+      {
+        m_buffer[m_fill++] = data[pos++];
+        if (m_fill == DeframePrefixSize)
+        {
+          if (validLength(m_buffer[1]))
           {
-            m_sendData_cb(m_buffer, ackSize);
+            m_crc.reset();
+          } else
+          {
+            frames += resync();
           }
-#endif
-          break;
+        }
+        continue;
+      }
+
+      const uint16_t total = DeframePrefixSize + m_buffer[1];
+      size_t take = total - m_fill;
+      if (take > (size - pos))
+      {
+        take = size - pos;
+      }
+      m_crc.copy(&m_buffer[m_fill], &data[pos], take);
+      m_fill = static_cast<uint16_t>(m_fill + take);
+      pos += take;
+
+      if (m_fill == total)
+      {
+        if (m_crc.valid())
+        {
+          m_fill = 0U;
+          m_sink.inputData(&m_buffer[DeframePrefixSize], m_buffer[1]);
+          ++frames;
+        } else
+        {
+          frames += resync();
         }
       }
     }
+    return frames;
+  }
 
-    return result::ok;
+private:
+  static bool validLength(uint8_t len) noexcept
+  {
+    return (len >= (HeaderSize + 2U)) && (len <= SYNCBUS_BUFFER_SIZE);
   }
 
-  // Register a (slotId, size, data*)
-  result addSlot(void *data, uint8_t slotId, uint8_t size) noexcept
+  // Offset of the first later SOF whose frame lies entirely inside the
+  // buffered bytes and passes its CRC, or 0
+  uint16_t innerFrame() const noexcept
   {
-    if (data == nullptr)
+    uint16_t at = 1U;
+    while ((at + DeframePrefixSize) <= m_fill)
+    {
+      const void *sof = std::memchr(&m_buffer[at], DeframeSof,
+                                    m_fill - DeframePrefixSize + 1U - at);
+      if (sof == nullptr)
+      {
+        break;
+      }
+      at = static_cast<uint16_t>(static_cast<const uint8_t*>(sof) - m_buffer);
+
+      const uint8_t len = m_buffer[at + 1U];
+      const uint16_t end = static_cast<uint16_t>(at + DeframePrefixSize + len);
+      if (validLength(len) && (end <= m_fill)
+          && checkCRC16(&m_buffer[at + DeframePrefixSize], len))
+      {
+        return at;
+      }
+      ++at;
+    }
+    return 0U;
+  }
+
+  // The buffered candidate was rejected: re-hunt inside the bytes it
+  // swallowed, delivering any complete frame found there (also inside a new
+  // candidate that is still incomplete).
+  uint16_t resync() noexcept
+  {
+    uint16_t frames = 0U;
+    uint16_t start = 1U;
+
+    for (;;)
+    {
+      while ((start < m_fill) && (m_buffer[start] != DeframeSof))
+      {
+        ++start;
+      }
+      if (start >= m_fill)
+      {
+        m_fill = 0U;
+        return frames;
+      }
+      m_fill = static_cast<uint16_t>(m_fill - start);
+      std::memmove(m_buffer, &m_buffer[start], m_fill);
+      start = 1U;
+
+      if (m_fill < DeframePrefixSize)
+      {
+        return frames;
+      }
+      const uint8_t len = m_buffer[1];
+      if (!validLength(len))
+      {
+        continue;
+      }
+
+      const uint16_t total = DeframePrefixSize + len;
+      if (m_fill < total)
+      {
+        const uint16_t inner = innerFrame();
+        if (inner != 0U)
+        {
+          const uint8_t innerLen = m_buffer[inner + 1U];
+          m_sink.inputData(&m_buffer[inner + DeframePrefixSize], innerLen);
+          ++frames;
+          start = static_cast<uint16_t>(inner + DeframePrefixSize + innerLen);
+          continue;
+        }
+        m_crc.reset();
+        m_crc.update(&m_buffer[DeframePrefixSize], m_fill - DeframePrefixSize);
+        return frames;
+      }
+      if (checkCRC16(&m_buffer[DeframePrefixSize], len))
+      {
+        m_sink.inputData(&m_buffer[DeframePrefixSize], len);
+        ++frames;
+        start = total;
+      }
+    }
+  }
+
+  Sink &m_sink;
+  uint16_t m_fill;                // bytes of the current candidate buffered
+  Crc16State m_crc;               // CRC of the buffered frame bytes
+  uint8_t m_buffer[DeframePrefixSize + SYNCBUS_BUFFER_SIZE];
+};
+
+// ============================================================================
+//                       COMPILE-TIME SLOT REGISTRY
+// ============================================================================
+// Server whose slots are all known at build time:
+//
+//   SyncBusStaticServer<Slots<Slot<1, DeviceStats>, Slot<2, uint8_t>>> srv(id);
+//   srv.get<1>().uptime_s = 10;
+//
+// The slot storage lives in the server, sizes are constants, the frame buffer
+// is sized for the largest slot and slotId dispatch is a constant compare
+// chain the compiler lowers to a switch.
+template<uint8_t id, typename T>
+struct Slot
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SyncBus: slot type must be trivially copyable");
+  static_assert((HeaderSize + sizeof(T) + 2U) <= SYNCBUS_BUFFER_SIZE,
+                "SyncBus: slot frame exceeds SYNCBUS_BUFFER_SIZE");
+
+  static constexpr uint8_t slotId = id;
+  using type = T;
+
+  T value;
+};
+
+template<typename ... S>
+struct Slots
+{
+};
+
+template<typename SlotList, typename Hooks = CallbackHooks<CompactFrame>>
+class SyncBusStaticServer;
+
+template<typename ... S, typename Hooks>
+class SyncBusStaticServer<Slots<S...>, Hooks>
+{
+  static_assert(sizeof...(S) > 0U, "SyncBus: empty slot registry");
+
+  static constexpr uint8_t SlotIds[] = { S::slotId... };
+  static constexpr size_t SlotSizes[] = { sizeof(typename S::type)... };
+
+  static constexpr bool uniqueIds() noexcept
+  {
+    for (size_t i = 0U; i < sizeof...(S); ++i)
+    {
+      for (size_t j = i + 1U; j < sizeof...(S); ++j)
+      {
+        if (SlotIds[i] == SlotIds[j])
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  static constexpr size_t indexOf(uint8_t slotId) noexcept
+  {
+    size_t i = 0U;
+    while ((i < sizeof...(S)) && (SlotIds[i] != slotId))
+    {
+      ++i;
+    }
+    return i;
+  }
+
+  static constexpr size_t maxPayload() noexcept
+  {
+    size_t max = 0U;
+    for (size_t size : SlotSizes)
+    {
+      max = (size > max) ? size : max;
+    }
+    return max;
+  }
+
+  static_assert(uniqueIds(), "SyncBus: duplicate slotId in registry");
+
+public:
+  static constexpr uint8_t numSlots = sizeof...(S);
+  // Largest reply; a slot whose tagged GetResp would exceed
+  // SYNCBUS_BUFFER_SIZE answers untagged (Slot only checks the untagged frame)
+  static constexpr size_t FrameMax =
+      ((HeaderSize + TidSize + maxPayload() + 2U) <= SYNCBUS_BUFFER_SIZE) ?
+          (HeaderSize + TidSize + maxPayload() + 2U) : SYNCBUS_BUFFER_SIZE;
+
+  using sendCtx_cb = CallbackHooks<CompactFrame>::sendCtx_cb;
+  using changedCtx_cb = CallbackHooks<CompactFrame>::changedCtx_cb;
+  using sendVecCtx_cb = CallbackHooks<CompactFrame>::sendVecCtx_cb;
+
+  explicit SyncBusStaticServer(uint32_t id, SyncBusSendData_cb SendData_cb =
+      nullptr, SyncBusDataChanged_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusStaticServer(id, Hooks(SendData_cb, DataChanged_cb))
+  {
+  }
+
+  // Callbacks receiving 'ctx' as their first argument
+  SyncBusStaticServer(uint32_t id, void *ctx, sendCtx_cb SendData_cb,
+      changedCtx_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusStaticServer(id, Hooks(ctx, SendData_cb, DataChanged_cb))
+  {
+  }
+
+  // Vectored send (see CallbackHooks): slot values are not staged
+  SyncBusStaticServer(SyncBusVectored_t, uint32_t id,
+      SyncBusSendVec_cb SendVec_cb,
+      SyncBusDataChanged_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusStaticServer(id, Hooks(SyncBusVectored, SendVec_cb,
+                                    DataChanged_cb))
+  {
+  }
+
+  SyncBusStaticServer(SyncBusVectored_t, uint32_t id, void *ctx,
+      sendVecCtx_cb SendVec_cb,
+      changedCtx_cb DataChanged_cb = nullptr) noexcept :
+      SyncBusStaticServer(id, Hooks(SyncBusVectored, ctx, SendVec_cb,
+                                    DataChanged_cb))
+  {
+  }
+
+  SyncBusStaticServer(uint32_t id, const Hooks &hooks) noexcept :
+      m_serverId(id), m_slots(), m_hooks(hooks)
+  {
+  }
+
+  void setId(uint32_t serverId) noexcept
+  {
+    m_serverId = serverId;
+  }
+
+  // Application access to the slot data
+  template<uint8_t slotId>
+  auto& get() noexcept
+  {
+    static_assert(indexOf(slotId) < sizeof...(S), "SyncBus: unknown slotId");
+    return std::get<indexOf(slotId)>(m_slots).value;
+  }
+
+  template<uint8_t slotId>
+  const auto& get() const noexcept
+  {
+    static_assert(indexOf(slotId) < sizeof...(S), "SyncBus: unknown slotId");
+    return std::get<indexOf(slotId)>(m_slots).value;
+  }
+
+  // Incoming data (GetReq / SetReq)
+  result inputData(const uint8_t *data, uint8_t size) noexcept
+  {
+    if (size < static_cast<uint8_t>(HeaderSize + 2U))
     {
       return result::errFault;
     }
-    if (m_numSlots >= numSlots)
+    if (!checkCRC16(data, size))
     {
-      return result::errOverflow;
+      return result::errCrc;
     }
 
-    // enforce maximum payload per frame for GET response
-    if ((static_cast<uint16_t>(HeaderSize) + size + 2U) > SYNCBUS_BUFFER_SIZE)
+    const uint32_t serverId = read_le32(&data[FrameServerId]);
+    if (serverId != m_serverId)
     {
-      return result::errOverflow;
+      return result::ok;
     }
 
-    m_clientSlots[m_numSlots].data = data;
-    m_clientSlots[m_numSlots].slotId = slotId;
-    m_clientSlots[m_numSlots].size = size;
-    ++m_numSlots;
+    const uint8_t slotId = data[FrameSlotId];
+    const auto function = static_cast<SyncBusFunc>(data[FrameFunction]
+        & static_cast<uint8_t>(~FuncFlagTid));
 
-    return result::ok;
+    // Tagged requests: the TID follows the header and is echoed back
+    const bool tagged = (data[FrameFunction] & FuncFlagTid) != 0U;
+    const uint8_t dataAt = tagged ? (FrameData + TidSize) : FrameData;
+    if (size < static_cast<uint8_t>(dataAt + 2U))
+    {
+      return result::errFault;
+    }
+    const uint8_t payloadLen = static_cast<uint8_t>(size - dataAt - 2U);
+    const uint16_t tid = tagged ? data[HeaderSize] : NoTid;
+
+    result res = result::ok;
+    static_cast<void>(((slotId == S::slotId ?
+        (res = handle(std::get<S>(m_slots), function, &data[dataAt],
+                      payloadLen, tid), true) :
+        false) || ...));
+    return res;
   }
 
 private:
+  template<typename SlotT>
+  result handle(SlotT &slot, SyncBusFunc function, const uint8_t *data,
+      uint8_t payloadLen, uint16_t tid) noexcept
+  {
+    constexpr uint8_t payload = sizeof(typename SlotT::type);
+    constexpr bool tidFits =
+        (HeaderSize + TidSize + payload + 2U) <= SYNCBUS_BUFFER_SIZE;
+
+    if (function == SyncBusFunc::GetReq)
+    {
+      sendFrame(m_hooks, m_buffer,
+                writeHeader(m_buffer, m_serverId, SlotT::slotId,
+                            SyncBusFunc::GetResp, tidFits ? tid : NoTid),
+                &slot.value, payload);
+    } else if (function == SyncBusFunc::SetReq)
+    {
+      if (payloadLen != payload)
+      {
+        return result::errFault;
+      }
+
+      std::memcpy(&slot.value, data, payload);
+      m_hooks.changed(m_serverId, SlotT::slotId,
+                      static_cast<uint8_t>(indexOf(SlotT::slotId)));
+
+#if !SYNCBUS_ENABLE_SET_ACK
+      if (tid == NoTid)
+      {
+        return result::ok;
+      }
+#endif
+      uint8_t ackSize = buildFrame(m_buffer, m_serverId, SlotT::slotId,
+                                   SyncBusFunc::SetResp, nullptr, 0U, tid);
+      m_hooks.send(m_buffer, ackSize);
+    }
+    return result::ok;
+  }
+
   uint32_t m_serverId;
-  uint8_t m_numSlots;
-  clientSlot_t m_clientSlots[numSlots];
-  SyncBusSendData_cb m_sendData_cb;
-  SyncBusDataChanged_cb m_dataChanged_cb;
-  uint8_t m_buffer[SYNCBUS_BUFFER_SIZE];
+  std::tuple<S...> m_slots;
+  Hooks m_hooks;
+  uint8_t m_buffer[FrameMax];
 };
 
 } // namespace SyncBus
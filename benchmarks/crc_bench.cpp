@@ -0,0 +1,107 @@
+// Benchmark do CRC16: ciclos por byte do motor selecionado por SYNCBUS_CRC_MODE
+// (e do kernel CLMUL, se habilitado) comparado ao laço bit a bit de referência.
+//
+// Um binário por variante:
+//   for m in BITWISE NIBBLE TABLE SLICE8 SLICE16; do
+//     g++ -std=c++17 -O2 -I.. -DSYNCBUS_CRC_MODE=SYNCBUS_CRC_$m crc_bench.cpp -o crc_$m && ./crc_$m
+//   done
+//   g++ -std=c++17 -O2 -I.. -DSYNCBUS_ENABLE_CRC_CLMUL=1 crc_bench.cpp -o crc_clmul && ./crc_clmul
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include "SyncBus.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#else
+#define BENCH_HAS_TSC 0
+#endif
+
+using namespace SyncBus;
+
+static const char* modeName()
+{
+#if SYNCBUS_CRC_MODE == SYNCBUS_CRC_BITWISE
+    return "bitwise";
+#elif SYNCBUS_CRC_MODE == SYNCBUS_CRC_NIBBLE
+    return "nibble";
+#elif SYNCBUS_CRC_MODE == SYNCBUS_CRC_TABLE
+    return "table";
+#elif SYNCBUS_CRC_MODE == SYNCBUS_CRC_SLICE8
+    return "slice8";
+#else
+    return "slice16";
+#endif
+}
+
+// -------------------- referência: laço bit a bit original --------------------
+static uint16_t crcBitwise(uint16_t crc, const uint8_t* buff, size_t len)
+{
+    for (size_t pos = 0; pos < len; ++pos) {
+        crc ^= buff[pos];
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 1U) ? static_cast<uint16_t>((crc >> 1) ^ 0xA001U)
+                             : static_cast<uint16_t>(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+// -------------------- medição -------------------------------------------------
+static volatile uint16_t g_sink;
+
+template<typename F>
+static void measure(const char* name, F&& crc, const uint8_t* buff, size_t len)
+{
+    const size_t iters = (size_t{1} << 24) / len + 1;
+    uint16_t acc = 0;
+
+    const auto t0 = std::chrono::steady_clock::now();
+#if BENCH_HAS_TSC
+    const uint64_t c0 = __rdtsc();
+#endif
+    for (size_t i = 0; i < iters; ++i) {
+        acc = static_cast<uint16_t>(acc ^ crc(buff, len));
+    }
+#if BENCH_HAS_TSC
+    const uint64_t c1 = __rdtsc();
+#endif
+    const auto t1 = std::chrono::steady_clock::now();
+    g_sink = acc;
+
+    const double bytes = static_cast<double>(iters) * static_cast<double>(len);
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+#if BENCH_HAS_TSC
+    std::printf("  %-8s len=%5zu  %7.3f ns/byte  %7.3f ciclos(TSC)/byte\n",
+                name, len, ns / bytes, static_cast<double>(c1 - c0) / bytes);
+#else
+    std::printf("  %-8s len=%5zu  %7.3f ns/byte\n", name, len, ns / bytes);
+#endif
+}
+
+int main()
+{
+    static uint8_t data[1472];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>(i * 131U + 7U);
+    }
+
+    std::printf("SYNCBUS_CRC_MODE=%s%s\n", modeName(),
+                SYNCBUS_ENABLE_CRC_CLMUL ? " + CLMUL" : "");
+    const size_t lens[] = { 8, 64, 255, 1472 };
+    for (size_t len : lens) {
+        if (crcBitwise(Crc16Init, data, len) != crc16Update(Crc16Init, data, len)) {
+            std::printf("ERRO: CRC diverge em len=%zu\n", len);
+            return 1;
+        }
+        measure("bitwise", [](const uint8_t* b, size_t n) {
+            return crcBitwise(Crc16Init, b, n);
+        }, data, len);
+        measure(modeName(), [](const uint8_t* b, size_t n) {
+            return crc16Update(Crc16Init, b, n);
+        }, data, len);
+    }
+    return 0;
+}
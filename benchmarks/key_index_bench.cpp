@@ -0,0 +1,162 @@
+// Benchmark do índice de chaves do cliente: busca binária no índice ordenado
+// por (serverId, slotId) (SyncBusClient::findData) contra a varredura linear
+// que ela substituiu, com 8, 64 e 255 slots registrados.
+//
+// "lookup" mede só a busca (cópias fiéis dos dois algoritmos sobre a mesma
+// tabela); "inputData" mede o caminho completo de uma GetResp no
+// SyncBusClient real (CRC + despacho + cópia do slot).
+//
+//   g++ -std=c++17 -O2 -I.. key_index_bench.cpp -o key_index_bench && ./key_index_bench
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+static constexpr size_t Lookups = 1U << 22;
+static constexpr size_t Frames = 1U << 20;
+
+static volatile uint32_t g_sink;
+
+static double nsPerOp(std::chrono::steady_clock::time_point t0, size_t ops)
+{
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count()
+           / static_cast<double>(ops);
+}
+
+// -------------------- tabela de slots (espelha m_serveSlots) -----------------
+struct Entry {
+    uint32_t serverId;
+    uint8_t slotId;
+};
+
+static uint64_t slotKey(uint32_t serverId, uint8_t slotId)
+{
+    return (static_cast<uint64_t>(serverId) << 8) | slotId;
+}
+
+// Varredura linear (implementação anterior)
+static uint8_t findLinear(const Entry* slots, uint8_t count,
+                          uint32_t serverId, uint8_t slotId)
+{
+    for (uint8_t i = 0; i < count; ++i) {
+        if ((slots[i].serverId == serverId) && (slots[i].slotId == slotId)) {
+            return i;
+        }
+    }
+    return NoSlot;
+}
+
+// Busca binária no índice ordenado (como SyncBusClient::findData)
+static uint8_t findSorted(const Entry* slots, const uint8_t* index,
+                          uint8_t count, uint32_t serverId, uint8_t slotId)
+{
+    const uint64_t key = slotKey(serverId, slotId);
+    uint8_t lo = 0;
+    uint8_t hi = count;
+    while (lo < hi) {
+        const uint8_t mid = static_cast<uint8_t>((lo + hi) / 2U);
+        const uint64_t midKey = slotKey(slots[index[mid]].serverId,
+                                        slots[index[mid]].slotId);
+        if (midKey == key) {
+            return index[mid];
+        }
+        if (midKey < key) {
+            lo = static_cast<uint8_t>(mid + 1U);
+        } else {
+            hi = mid;
+        }
+    }
+    return NoSlot;
+}
+
+// -------------------- cliente real -------------------------------------------
+static void noSend(const uint8_t*, uint8_t) {}
+
+template<uint8_t N>
+static void run()
+{
+    // Slots de vários servidores, registrados em ordem embaralhada
+    Entry slots[N];
+    uint8_t index[N];
+    std::mt19937 rng(N);
+    for (uint8_t i = 0; i < N; ++i) {
+        slots[i] = { 100U + (i % 4U), static_cast<uint8_t>(i / 4U) };
+    }
+    for (uint8_t i = N - 1; i > 0; --i) {
+        const uint8_t j = static_cast<uint8_t>(rng() % (i + 1U));
+        const Entry t = slots[i];
+        slots[i] = slots[j];
+        slots[j] = t;
+    }
+    for (uint8_t n = 0; n < N; ++n) {
+        const uint64_t key = slotKey(slots[n].serverId, slots[n].slotId);
+        uint8_t pos = n;
+        while ((pos > 0) && (slotKey(slots[index[pos - 1]].serverId,
+                                     slots[index[pos - 1]].slotId) > key)) {
+            index[pos] = index[pos - 1];
+            --pos;
+        }
+        index[pos] = n;
+    }
+
+    // Sequência de consultas aleatórias (todas acertam)
+    static uint8_t queries[Lookups];
+    for (size_t q = 0; q < Lookups; ++q) {
+        queries[q] = static_cast<uint8_t>(rng() % N);
+    }
+
+    uint32_t acc = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < Lookups; ++q) {
+        const Entry& e = slots[queries[q]];
+        acc += findLinear(slots, N, e.serverId, e.slotId);
+    }
+    const double linear = nsPerOp(t0, Lookups);
+
+    t0 = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < Lookups; ++q) {
+        const Entry& e = slots[queries[q]];
+        acc += findSorted(slots, index, N, e.serverId, e.slotId);
+    }
+    const double sorted = nsPerOp(t0, Lookups);
+
+    // Caminho completo: GetResp de 4 bytes para slots aleatórios
+    static SyncBusClient<N> client(noSend);
+    static uint32_t values[N];
+    for (uint8_t i = 0; i < N; ++i) {
+        client.addData(&values[i], slots[i].serverId, slots[i].slotId,
+                       static_cast<uint8_t>(sizeof(uint32_t)));
+    }
+    static uint8_t frames[N][HeaderSize + sizeof(uint32_t) + 2U];
+    uint8_t lens[N];
+    for (uint8_t i = 0; i < N; ++i) {
+        const uint32_t v = i;
+        lens[i] = buildFrame(frames[i], slots[i].serverId, slots[i].slotId,
+                             SyncBusFunc::GetResp, &v,
+                             static_cast<uint8_t>(sizeof(v)));
+    }
+    t0 = std::chrono::steady_clock::now();
+    for (size_t f = 0; f < Frames; ++f) {
+        const uint8_t i = queries[f];
+        acc += static_cast<uint32_t>(client.inputData(frames[i], lens[i]));
+    }
+    const double input = nsPerOp(t0, Frames);
+    g_sink = acc;
+
+    std::printf("  slots=%3u  lookup linear %6.2f ns  ordenado %6.2f ns  "
+                "(%.1fx)  inputData %6.2f ns\n",
+                N, linear, sorted, linear / sorted, input);
+}
+
+int main()
+{
+    run<8>();
+    run<64>();
+    run<255>();
+    return 0;
+}
@@ -162,6 +162,14 @@ static void runScript()
     g_client.getData(kServerId, 3);
     printClientMirror();
 
+    std::cout << "\n[4] Servidor modifica os dados e cliente faz GET de todos os slots em um frame:\n";
+    g_srv_u8 = 201;
+    g_srv_stats.uptime_s += 60;
+
+    const uint8_t allSlots[] = { 0, 1, 2, 3 };
+    g_client.getMultiData(kServerId, allSlots, sizeof(allSlots));
+    printClientMirror();
+
     std::cout << "\n=== Fim do roteiro ===\n";
 }
 
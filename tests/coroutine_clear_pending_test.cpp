@@ -0,0 +1,113 @@
+// clearPending() com corrotinas aguardando: cada uma retoma com errTimeout
+// e volta a aguardar na própria retomada, reocupando entradas da tabela de
+// pendências. As novas requisições não podem ser apagadas pela limpeza e
+// precisam completar quando o servidor responde.
+//
+//   g++ -std=c++20 -O2 -I.. coroutine_clear_pending_test.cpp -o coroutine_clear_pending_test && ./coroutine_clear_pending_test
+
+#define SYNCBUS_MAX_PENDING 3U
+#include <coroutine>
+#include <cstdio>
+#include <vector>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+// -------------------- barramento em memória ----------------------------------
+static std::vector<std::vector<uint8_t>> g_toServer;
+static std::vector<std::vector<uint8_t>> g_toClient;
+
+static void clientSend(const uint8_t* data, uint8_t size)
+{
+    g_toServer.emplace_back(data, data + size);
+}
+
+static void serverSend(const uint8_t* data, uint8_t size)
+{
+    g_toClient.emplace_back(data, data + size);
+}
+
+static SyncBusServer<4> g_server(7, serverSend);
+static SyncBusClient<4> g_client(clientSend);
+static uint32_t g_serverValues[3] = { 10, 20, 30 };
+static uint32_t g_clientValues[3] = {};
+
+static result g_first[3];
+static result g_second[3];
+static int g_done = 0;
+
+Task reader(uint8_t slot)
+{
+    g_first[slot] = co_await g_client.get(7, slot);
+    // Retomado dentro de clearPending(): aguarda de novo na mesma hora
+    g_second[slot] = co_await g_client.get(7, slot);
+    ++g_done;
+}
+
+int main()
+{
+    for (uint8_t i = 0; i < 3; ++i) {
+        g_server.addSlot(&g_serverValues[i], static_cast<uint8_t>(i + 1U));
+        g_client.addData(&g_clientValues[i], 7, static_cast<uint8_t>(i + 1U),
+                         sizeof(uint32_t));
+    }
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        reader(i);
+    }
+    if (g_client.pending() != 3U) {
+        std::printf("FALHA: %u pendentes antes da limpeza\n", g_client.pending());
+        return 1;
+    }
+
+    // Link reiniciado: as requisições em voo se perdem
+    g_toServer.clear();
+    g_client.clearPending();
+
+    unsigned failures = 0;
+    for (uint8_t i = 0; i < 3; ++i) {
+        if (g_first[i] != result::errTimeout) {
+            std::printf("FALHA: slot %u retomou com %d\n", i, static_cast<int>(g_first[i]));
+            ++failures;
+        }
+    }
+    if (g_client.pending() != 3U) {
+        std::printf("FALHA: %u pendentes após a limpeza (esperado 3)\n",
+                    g_client.pending());
+        ++failures;
+    }
+
+    // O servidor responde às novas requisições
+    for (const auto& frame : g_toServer) {
+        g_server.inputData(frame.data(), static_cast<uint8_t>(frame.size()));
+    }
+    for (const auto& frame : g_toClient) {
+        g_client.inputData(frame.data(), static_cast<uint8_t>(frame.size()));
+    }
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        if ((g_second[i] != result::ok) || (g_clientValues[i] != g_serverValues[i])) {
+            std::printf("FALHA: slot %u segunda leitura r=%d v=%u\n", i,
+                        static_cast<int>(g_second[i]), g_clientValues[i]);
+            ++failures;
+        }
+    }
+    if ((g_done != 3) || (g_client.pending() != 0U)) {
+        std::printf("FALHA: %d corrotinas concluídas, %u pendentes\n", g_done,
+                    g_client.pending());
+        ++failures;
+    }
+
+    std::printf("clearPending: %u falhas\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
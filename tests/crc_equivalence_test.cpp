@@ -0,0 +1,136 @@
+// Equivalência dos motores CRC16: cada caminho (crc16Portable, crc16Update,
+// crc16Copy, Crc16State e o kernel CLMUL, se habilitado) é comparado ao laço
+// bit a bit de referência sobre todos os valores de byte, comprimentos
+// 0..MaxLen, inícios desalinhados, CRCs iniciais aleatórios e fatiamentos
+// aleatórios. Retorna 0 se tudo confere.
+//
+// Um binário por variante:
+//   for m in BITWISE NIBBLE TABLE SLICE8 SLICE16; do
+//     g++ -std=c++17 -O2 -I.. -DSYNCBUS_CRC_MODE=SYNCBUS_CRC_$m crc_equivalence_test.cpp -o crc_eq && ./crc_eq
+//   done
+//   g++ -std=c++17 -O2 -I.. -DSYNCBUS_ENABLE_CRC_CLMUL=1 crc_equivalence_test.cpp -o crc_eq && ./crc_eq
+//   # AArch64 (PMULL), no alvo ou sob qemu-aarch64:
+//   g++ -std=c++17 -O2 -march=armv8-a+crypto -I.. -DSYNCBUS_ENABLE_CRC_CLMUL=1
+//       -DSYNCBUS_ENABLE_CRC_PMULL=1 crc_equivalence_test.cpp -o crc_eq && ./crc_eq
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+static constexpr size_t MaxLen = 600U;   // cobre vários blocos de 16 do CLMUL
+static constexpr size_t MaxOffset = 16U; // inícios desalinhados
+static constexpr int Seeds = 64;
+
+static unsigned g_failures = 0;
+
+// -------------------- referência: laço bit a bit original --------------------
+static uint16_t crcReference(uint16_t crc, const uint8_t* buff, size_t len)
+{
+    for (size_t pos = 0; pos < len; ++pos) {
+        crc ^= buff[pos];
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 1U) ? static_cast<uint16_t>((crc >> 1) ^ 0xA001U)
+                             : static_cast<uint16_t>(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static void check(const char* what, uint16_t got, uint16_t want,
+                  uint16_t init, size_t off, size_t len)
+{
+    if (got != want) {
+        if (g_failures < 20) {
+            std::printf("FALHA %s: init=0x%04X off=%zu len=%zu got=0x%04X want=0x%04X\n",
+                        what, init, off, len, got, want);
+        }
+        ++g_failures;
+    }
+}
+
+// -------------------- todos os caminhos contra a referência ------------------
+static void checkAll(std::mt19937& rng, const uint8_t* buff, uint16_t init,
+                     size_t off, size_t len)
+{
+    const uint8_t* p = buff + off;
+    const uint16_t want = crcReference(init, p, len);
+
+    check("crc16Portable", crc16Portable(init, p, len), want, init, off, len);
+    check("crc16Update", crc16Update(init, p, len), want, init, off, len);
+
+    uint8_t dst[MaxLen + MaxOffset];
+    check("crc16Copy", crc16Copy(init, dst + off, p, len), want, init, off, len);
+    if (std::memcmp(dst + off, p, len) != 0) {
+        std::printf("FALHA crc16Copy: cópia difere (off=%zu len=%zu)\n", off, len);
+        ++g_failures;
+    }
+
+    // Crc16State alimentado em pedaços aleatórios, alternando update/copy/byte
+    // (o estado sempre parte de Crc16Init)
+    Crc16State state;
+    size_t pos = 0;
+    while (pos < len) {
+        const size_t chunk = std::min<size_t>(len - pos, rng() % 80U);
+        switch (rng() % 3U) {
+        case 0:
+            state.update(p + pos, chunk);
+            break;
+        case 1:
+            state.copy(dst + off + pos, p + pos, chunk);
+            break;
+        default:
+            for (size_t i = 0; i < chunk; ++i) {
+                state.update(p[pos + i]);
+            }
+            break;
+        }
+        pos += chunk;
+    }
+    check("Crc16State", state.finalize(), crcReference(Crc16Init, p, len),
+          Crc16Init, off, len);
+}
+
+int main()
+{
+    // Todos os valores de byte, isolados, sobre todos os CRCs iniciais
+    for (uint32_t init = 0; init <= 0xFFFFU; init += 0x0101U) {
+        for (uint32_t b = 0; b <= 0xFFU; ++b) {
+            const uint8_t byte = static_cast<uint8_t>(b);
+            check("byte", crc16Update(static_cast<uint16_t>(init), &byte, 1U),
+                  crcReference(static_cast<uint16_t>(init), &byte, 1U),
+                  static_cast<uint16_t>(init), 0U, 1U);
+        }
+    }
+
+    std::mt19937 rng(12345U);
+    uint8_t buff[MaxLen + MaxOffset];
+
+    // Padrão que percorre todos os valores de byte, depois sementes aleatórias
+    for (int seed = 0; seed <= Seeds; ++seed) {
+        for (size_t i = 0; i < sizeof(buff); ++i) {
+            buff[i] = (seed == 0) ? static_cast<uint8_t>(i)
+                                  : static_cast<uint8_t>(rng());
+        }
+        const uint16_t init = (seed == 0) ? Crc16Init
+                                          : static_cast<uint16_t>(rng());
+        for (size_t off = 0; off < MaxOffset; ++off) {
+            for (size_t len = 0; len <= MaxLen; ++len) {
+                checkAll(rng, buff, init, off, len);
+            }
+        }
+    }
+
+    std::printf("CRC16 %s: %u falhas\n",
+#if defined(SYNCBUS_CRC_CLMUL_X86) || defined(SYNCBUS_CRC_CLMUL_ARM)
+                "(CLMUL)",
+#else
+                "(portável)",
+#endif
+                g_failures);
+    return (g_failures == 0) ? 0 : 1;
+}
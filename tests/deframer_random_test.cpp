@@ -0,0 +1,140 @@
+// Teste aleatório do SyncBusDeframer: quadros válidos intercalados com lixo
+// (inclusive 0x7E seguido de LEN plausível) e entregues em pedaços de tamanho
+// aleatório. Quando a linha fica quieta (idle()), todo quadro já transmitido
+// precisa ter chegado ao sink, em ordem — sem esperar por bytes que não vêm.
+//
+//   g++ -std=c++17 -O2 -I.. deframer_random_test.cpp -o deframer_random_test && ./deframer_random_test
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+static constexpr int Rounds = 2000;
+static constexpr int FramesPerRound = 16;
+
+// -------------------- sink: registra os quadros recebidos --------------------
+struct Sink {
+    std::vector<std::vector<uint8_t>> frames;
+
+    result inputData(const uint8_t* data, uint8_t size)
+    {
+        frames.emplace_back(data, data + size);
+        return result::ok;
+    }
+};
+
+// Lixo: bytes aleatórios com 0x7E frequente, às vezes seguido de LEN válido
+static void garbage(std::mt19937& rng, std::vector<uint8_t>& out)
+{
+    const unsigned n = rng() % 24U;
+    for (unsigned i = 0; i < n; ++i) {
+        switch (rng() % 4U) {
+        case 0:
+            out.push_back(DeframeSof);
+            out.push_back(static_cast<uint8_t>(HeaderSize + 2U
+                + rng() % (SYNCBUS_BUFFER_SIZE - HeaderSize - 1U)));
+            break;
+        case 1:
+            out.push_back(DeframeSof);
+            break;
+        default:
+            out.push_back(static_cast<uint8_t>(rng()));
+            break;
+        }
+    }
+}
+
+// Os esperados, em ordem, entre os entregues. Lixo cujo CRC confere por
+// acaso (2^-16 por candidato) é entregue como quadro e pode engolir o
+// quadro real seguinte; isso é limite do CRC16, não travamento: só conta
+// como falha o quadro perdido sem um extra que o explique.
+static bool delivered(const std::vector<std::vector<uint8_t>>& got,
+                      const std::vector<std::vector<uint8_t>>& expected,
+                      unsigned& collisions)
+{
+    size_t next = 0;
+    for (const auto& frame : got) {
+        if ((next < expected.size()) && (frame == expected[next])) {
+            ++next;
+        }
+    }
+    const size_t missing = expected.size() - next;
+    const size_t extra = got.size() - next;
+    collisions = static_cast<unsigned>(extra);
+    return missing <= extra;
+}
+
+int main()
+{
+    std::mt19937 rng(2024U);
+    unsigned failures = 0;
+    unsigned collisions = 0;
+
+    for (int round = 0; round < Rounds; ++round) {
+        Sink sink;
+        SyncBusDeframer<Sink> deframer(sink);
+        std::vector<std::vector<uint8_t>> expected;
+        bool ok = true;
+        unsigned extra = 0;
+
+        for (int f = 0; (f < FramesPerRound) && ok; ++f) {
+            // Lixo seguido de um quadro
+            std::vector<uint8_t> stream;
+            garbage(rng, stream);
+
+            uint8_t payload[SYNCBUS_BUFFER_SIZE];
+            const uint8_t payloadLen = static_cast<uint8_t>(
+                rng() % (SYNCBUS_BUFFER_SIZE - HeaderSize - 1U));
+            for (uint8_t i = 0; i < payloadLen; ++i) {
+                payload[i] = (rng() % 8U == 0U) ? DeframeSof
+                                                : static_cast<uint8_t>(rng());
+            }
+            uint8_t frame[SYNCBUS_BUFFER_SIZE];
+            const uint8_t len = buildFrame(frame, rng(),
+                                           static_cast<uint8_t>(rng()),
+                                           SyncBusFunc::GetResp, payload,
+                                           payloadLen);
+            uint8_t prefix[DeframePrefixSize];
+            writeFramePrefix(prefix, len);
+            stream.insert(stream.end(), prefix, prefix + DeframePrefixSize);
+            stream.insert(stream.end(), frame, frame + len);
+            expected.emplace_back(frame, frame + len);
+
+            // Entrega em pedaços aleatórios
+            size_t pos = 0;
+            while (pos < stream.size()) {
+                size_t chunk = 1U + rng() % 40U;
+                if (chunk > stream.size() - pos) {
+                    chunk = stream.size() - pos;
+                }
+                deframer.input(&stream[pos], chunk);
+                pos += chunk;
+            }
+
+            // Às vezes o transmissor para e espera resposta (timeout de
+            // leitura): todos os quadros até aqui já devem ter chegado
+            if ((rng() % 2U == 0U) || (f == FramesPerRound - 1)) {
+                deframer.idle();
+                ok = delivered(sink.frames, expected, extra);
+            }
+        }
+
+        if (!ok) {
+            if (failures < 10) {
+                std::printf("FALHA rodada %d: %zu quadros esperados, %zu entregues\n",
+                            round, expected.size(), sink.frames.size());
+            }
+            ++failures;
+        }
+        collisions += extra;
+    }
+
+    std::printf("deframer: %u falhas em %d rodadas (%u colisões de CRC)\n",
+                failures, Rounds, collisions);
+    return (failures == 0) ? 0 : 1;
+}
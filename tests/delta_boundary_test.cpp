@@ -0,0 +1,94 @@
+// DeltaResp no limite do buffer: slot de 56 bytes com o buffer padrão de 64
+// (o maior que addSlot aceita), pedido com GetDeltaReq cru. Para cada
+// tamanho de trecho alterado, o frame de resposta deve caber em
+// SYNCBUS_BUFFER_SIZE, reconstruir o valor do servidor e o servidor deve
+// continuar atendendo (um byte a mais sobrescrevia m_serverId).
+//
+//   g++ -std=c++17 -O1 -fsanitize=address,undefined -I.. delta_boundary_test.cpp -o delta_boundary_test && ./delta_boundary_test
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+struct Big {
+    uint8_t b[SYNCBUS_BUFFER_SIZE - HeaderSize - 2U];
+};
+
+static uint8_t g_reply[300];
+static unsigned g_replyLen = 0;
+static unsigned g_replies = 0;
+
+static void toClient(const uint8_t* data, uint8_t size)
+{
+    std::memcpy(g_reply, data, size);
+    g_replyLen = size;
+    ++g_replies;
+}
+
+static SyncBusServer<1> g_server(9, toClient);
+
+// Envia uma requisição crua e devolve o número de respostas
+static unsigned request(SyncBusFunc function, const void* payload, uint8_t len)
+{
+    uint8_t frame[SYNCBUS_BUFFER_SIZE];
+    const uint8_t size = buildFrame(frame, 9, 1, function, payload, len);
+    g_replies = 0;
+    g_server.inputData(frame, size);
+    return g_replies;
+}
+
+int main()
+{
+    static Big server{}, serverRef, mirror{};
+    g_server.addSlot(&server, 1, sizeof(Big));
+    g_server.enableDelta(1, &serverRef);
+
+    unsigned failures = 0;
+    uint16_t version = 0;  // addSlot começa em 0; markDirty incrementa
+
+    // Sem versão: o valor inteiro vira a referência do servidor
+    request(SyncBusFunc::GetDeltaReq, nullptr, 0);
+    std::memcpy(&mirror, &g_reply[FrameData], sizeof(Big));
+
+    for (size_t run = 1; run <= sizeof(Big::b); ++run) {
+        for (size_t k = 0; k < run; ++k) {
+            server.b[k] = static_cast<uint8_t>(server.b[k] + 1U + run);
+        }
+        const uint16_t refVersion = version;
+        g_server.markDirty(1);
+        ++version;
+
+        uint8_t have[VersionSize];
+        write_le16(have, refVersion);
+        const unsigned replies = request(SyncBusFunc::GetDeltaReq, have, VersionSize);
+        const auto function = static_cast<SyncBusFunc>(g_reply[FrameFunction]);
+
+        bool ok = (replies == 1U) && (g_replyLen <= SYNCBUS_BUFFER_SIZE)
+            && checkCRC16(g_reply, static_cast<uint8_t>(g_replyLen));
+        if (ok && (function == SyncBusFunc::DeltaResp)) {
+            ok = applyDelta<CompactFrame>(mirror.b, sizeof(Big),
+                                          &g_reply[FrameData + 2U * VersionSize],
+                                          static_cast<uint8_t>(g_replyLen - FrameData
+                                              - 2U * VersionSize - 2U));
+        } else if (ok && (function == SyncBusFunc::GetResp)) {
+            std::memcpy(&mirror, &g_reply[FrameData], sizeof(Big));
+        } else {
+            ok = false;
+        }
+        ok = ok && (std::memcmp(&mirror, &server, sizeof(Big)) == 0);
+
+        // O servidor ainda responde pelo próprio id
+        ok = ok && (request(SyncBusFunc::GetReq, nullptr, 0) == 1U);
+        if (!ok) {
+            std::printf("FALHA run=%zu: fn=%u len=%u\n", run,
+                        static_cast<unsigned>(function), g_replyLen);
+            ++failures;
+        }
+    }
+
+    std::printf("delta no limite: %u falhas\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
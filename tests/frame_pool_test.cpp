@@ -0,0 +1,204 @@
+// SyncBusFramePool: várias threads disputam poucos frames, cada uma marca o
+// frame inteiro com um padrão próprio e o confere antes de devolvê-lo; um
+// frame entregue a duas threads ao mesmo tempo (lista livre corrompida, ABA)
+// aparece como padrão trocado. Depois, cliente e servidor com pool: frames
+// em voo não são sobrescritos, pool esgotado devolve errBusy e tudo volta ao
+// pool. Retorna 0 se tudo confere.
+//
+//   g++ -std=c++17 -O1 -fsanitize=address,undefined -pthread -I.. frame_pool_test.cpp -o frame_pool_test && ./frame_pool_test
+//   g++ -std=c++17 -O1 -fsanitize=thread -pthread -I.. frame_pool_test.cpp -o frame_pool_test && ./frame_pool_test
+
+#define SYNCBUS_ENABLE_FRAME_POOL 1
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+static constexpr uint16_t NumFrames = 8U;
+static constexpr int NumThreads = 4;
+static constexpr int Rounds = 200000;
+
+static unsigned g_failures = 0;
+
+static void check(bool ok, const char* what)
+{
+    if (!ok) {
+        std::printf("FALHA: %s\n", what);
+        ++g_failures;
+    }
+}
+
+// ---- Disputa entre threads -------------------------------------------------
+
+static void stress()
+{
+    static SyncBusFrame<> frames[NumFrames];
+    SyncBusFramePool<> pool(frames, NumFrames);
+    std::atomic<unsigned> corrupted{0};
+    std::atomic<unsigned> acquired{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NumThreads; ++t) {
+        threads.emplace_back([&, t] {
+            uint8_t* held[2] = {nullptr, nullptr};
+            uint8_t stamp[2] = {0U, 0U};
+            for (int i = 0; i < Rounds; ++i) {
+                // Segura até dois frames, para que outros sejam tirados e
+                // devolvidos entre o load e o CAS desta thread
+                const int k = i & 1;
+                if (held[k] != nullptr) {
+                    for (size_t b = 0; b < SYNCBUS_BUFFER_SIZE; ++b) {
+                        if (held[k][b] != stamp[k]) {
+                            ++corrupted;
+                            break;
+                        }
+                    }
+                    pool.release(held[k]);
+                    held[k] = nullptr;
+                }
+                uint8_t* f = pool.acquire();
+                if (f != nullptr) {
+                    stamp[k] = static_cast<uint8_t>((t << 6) | (i & 0x3F));
+                    std::memset(f, stamp[k], SYNCBUS_BUFFER_SIZE);
+                    held[k] = f;
+                    ++acquired;
+                }
+            }
+            for (uint8_t* f : held) {
+                pool.release(f);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    check(corrupted.load() == 0U, "frame entregue a duas threads");
+    check(acquired.load() > 0U, "nenhum frame obtido");
+    check(pool.available() == NumFrames, "frames perdidos após a disputa");
+
+    // Todos distintos e do pool; ponteiros alheios são ignorados
+    uint8_t* all[NumFrames];
+    for (auto& f : all) {
+        f = pool.acquire();
+        check((f != nullptr) && pool.owns(f), "frame do pool");
+    }
+    check(pool.acquire() == nullptr, "pool vazio devolve nullptr");
+    for (uint16_t a = 0; a < NumFrames; ++a) {
+        for (uint16_t b = static_cast<uint16_t>(a + 1U); b < NumFrames; ++b) {
+            check(all[a] != all[b], "frame repetido");
+        }
+    }
+    uint8_t foreign[SYNCBUS_BUFFER_SIZE];
+    pool.release(foreign);
+    pool.release(all[0] + 1);
+    check(pool.available() == 0U, "release de ponteiro alheio");
+    for (auto f : all) {
+        pool.release(f);
+    }
+    check(pool.available() == NumFrames, "frames devolvidos");
+}
+
+// ---- Cliente e servidor com frames em voo ----------------------------------
+
+using Client = SyncBusClient<3>;
+using Server = SyncBusServer<3>;
+using Link = std::deque<std::pair<const uint8_t*, uint8_t>>;
+
+static SyncBusFrame<> g_clientFrames[3];
+static SyncBusFrame<> g_serverFrames[2];
+static SyncBusFramePool<> g_clientPool(g_clientFrames, 3U);
+static SyncBusFramePool<> g_serverPool(g_serverFrames, 2U);
+static Link g_toServer, g_toClient;
+
+static void clientSend(const uint8_t* data, uint8_t size)
+{
+    check(g_clientPool.owns(data), "frame do cliente fora do pool");
+    g_toServer.emplace_back(data, size);
+}
+
+static void serverSend(const uint8_t* data, uint8_t size)
+{
+    check(g_serverPool.owns(data), "frame do servidor fora do pool");
+    g_toClient.emplace_back(data, size);
+}
+
+static Client g_client(clientSend);
+static Server g_server(7, serverSend);
+
+// Entrega os frames na ordem, devolvendo cada um ao pool depois de lido
+static void pump()
+{
+    while (!g_toServer.empty() || !g_toClient.empty()) {
+        if (!g_toServer.empty()) {
+            const auto f = g_toServer.front();
+            g_toServer.pop_front();
+            g_server.inputData(f.first, f.second);
+            g_clientPool.release(f.first);
+        }
+        if (!g_toClient.empty()) {
+            const auto f = g_toClient.front();
+            g_toClient.pop_front();
+            g_client.inputData(f.first, f.second);
+            g_serverPool.release(f.first);
+        }
+    }
+}
+
+static void inFlight()
+{
+    g_client.setFramePool(&g_clientPool);
+    g_server.setFramePool(&g_serverPool);
+
+    static uint32_t local[3] = {};
+    static uint32_t remote[3] = {0x11111111U, 0x22222222U, 0x33333333U};
+    for (uint8_t i = 0; i < 3U; ++i) {
+        g_client.addData(&local[i], 7, static_cast<uint8_t>(i + 1U), 4);
+        g_server.addSlot(&remote[i], static_cast<uint8_t>(i + 1U), 4);
+    }
+
+    // Três pedidos em voo esgotam o pool do cliente
+    for (uint8_t i = 0; i < 3U; ++i) {
+        check(g_client.getData(7, i) == result::ok,
+              "pedido com frame livre");
+    }
+    check(g_client.getData(7, 0) == result::errBusy, "pool esgotado");
+    check(g_toServer.size() == 3U, "frames em voo");
+    pump();
+    check(std::memcmp(local, remote, sizeof(local)) == 0, "valores lidos");
+    // O servidor já guarda o frame da próxima resposta; o cliente, que
+    // esgotou o pool, só pega outro no próximo pedido
+    check(g_clientPool.available() == 3U, "frames do cliente devolvidos");
+    check(g_serverPool.available() == 1U, "frames do servidor devolvidos");
+
+    // SETs em voo: o segundo não pode sobrescrever o primeiro
+    local[0] = 100U;
+    local[1] = 200U;
+    g_client.setData(7, 0);
+    g_client.setData(7, 1);
+    pump();
+    check((remote[0] == 100U) && (remote[1] == 200U), "valores escritos");
+    check(g_clientPool.available() == 2U, "frames devolvidos após SET");
+
+    // Desligar o pool devolve o frame guardado
+    g_client.setFramePool(nullptr);
+    g_server.setFramePool(nullptr);
+    check(g_clientPool.available() == 3U, "pool do cliente completo");
+    check(g_serverPool.available() == 2U, "pool do servidor completo");
+}
+
+int main()
+{
+    stress();
+    inFlight();
+
+    std::printf("pool de frames: %u falhas\n", g_failures);
+    return (g_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+// Slots concorrentes (SYNCBUS_ENABLE_SEQLOCK): duas threads publicam valores
+// coerentes (todos os campos derivados de 'a') no mesmo slot, outra lê com
+// snapshot(), e a thread do barramento atende GETs e envia atualizações a um
+// cliente assinante. Nenhuma cópia — snapshot, resposta GET ou publicação —
+// pode misturar dois valores. Por fim, um SET do cliente passa pelo mesmo
+// seqlock. Retorna 0 se tudo confere.
+//
+//   g++ -std=c++17 -O1 -fsanitize=address,undefined -pthread -I.. seqlock_test.cpp -o seqlock_test && ./seqlock_test
+
+#define SYNCBUS_ENABLE_SEQLOCK 1
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+struct Stats {
+    uint32_t a, b, c, d, e, f, g, h;
+};
+
+static constexpr uint32_t Writes = 200000U;
+static constexpr unsigned MinReads = 2000U;  // por leitor, mesmo num só núcleo
+
+static Stats make(uint32_t a)
+{
+    return Stats{a, a * 2U, a * 3U, ~a, a ^ 0x5A5A5A5AU, a + 1U, a << 3, a + 7U};
+}
+
+static bool coherent(const Stats& s)
+{
+    const Stats m = make(s.a);
+    return (s.b == m.b) && (s.c == m.c) && (s.d == m.d) && (s.e == m.e)
+        && (s.f == m.f) && (s.g == m.g) && (s.h == m.h);
+}
+
+static void toServer(const uint8_t* data, uint8_t size);
+static void toClient(const uint8_t* data, uint8_t size);
+
+static unsigned g_torn = 0;      // respostas/atualizações misturadas
+static unsigned g_received = 0;
+
+static void changed(uint8_t)
+{
+    ++g_received;
+}
+
+static SyncBusClient<1> g_client(toServer, changed);
+static SyncBusServer<1> g_server(1, toClient);
+static Stats g_local{};
+static Stats g_shared = make(0);
+
+static void toServer(const uint8_t* data, uint8_t size)
+{
+    g_server.inputData(data, size);
+}
+
+static void toClient(const uint8_t* data, uint8_t size)
+{
+    g_client.inputData(data, size);
+    if (!coherent(g_local)) {
+        ++g_torn;
+    }
+}
+
+int main()
+{
+    unsigned failures = 0;
+    g_client.addData(&g_local, 1, 5, sizeof(Stats));
+    const auto slot = g_server.addSlot(&g_shared, 5);
+    g_client.subscribe(1, 0);
+
+    std::atomic<int> writing{2};
+    std::atomic<unsigned> snapTorn{0}, snaps{0}, gets{0};
+
+    // Escritores pares e ímpares disputam o slot até os leitores terem
+    // rodado o bastante
+    auto writer = [&](uint32_t first) {
+        for (uint32_t a = first;
+             (a < Writes) || (snaps.load() < MinReads) || (gets.load() < MinReads);
+             a += 2U) {
+            g_server.publish(slot, make(a));
+        }
+        --writing;
+    };
+    std::thread even(writer, 2U), odd(writer, 1U);
+    std::thread reader([&] {
+        while (writing.load() > 0) {
+            Stats v;
+            g_server.snapshot(slot, v);
+            if (!coherent(v)) {
+                ++snapTorn;
+            }
+            ++snaps;
+        }
+    });
+
+    // Thread do barramento: GETs e atualizações dos assinantes
+    uint32_t tick = 0;
+    while (writing.load() > 0) {
+        g_client.getData(1, 0);
+        if ((++gets & 15U) == 0U) {
+            g_server.poll(++tick);
+        }
+    }
+    even.join();
+    odd.join();
+    reader.join();
+    g_server.poll(++tick);
+
+    if ((g_torn != 0U) || (snapTorn.load() != 0U)) {
+        std::printf("FALHA: %u respostas e %u snapshots misturados\n", g_torn,
+                    snapTorn.load());
+        ++failures;
+    }
+    if ((g_received == 0U) || (snaps.load() == 0U)) {
+        std::printf("FALHA: nada recebido (%u respostas, %u snapshots)\n",
+                    g_received, snaps.load());
+        ++failures;
+    }
+
+    // O último valor publicado chega ao cliente
+    Stats last;
+    g_server.snapshot(slot, last);
+    g_client.getData(1, 0);
+    if ((g_local.a != last.a) || (last.a < Writes - 2U)) {
+        std::printf("FALHA: último valor %u, esperado %u\n", g_local.a, last.a);
+        ++failures;
+    }
+
+    // SET do cliente escrito sob o seqlock
+    g_local = make(12345U);
+    g_client.setData(1, 0);
+    Stats v;
+    g_server.snapshot(slot, v);
+    if ((v.a != 12345U) || !coherent(v)) {
+        std::printf("FALHA: SET do cliente (a=%u)\n", v.a);
+        ++failures;
+    }
+
+    std::printf("seqlock: %u falhas (%u GETs, %u snapshots)\n", failures,
+                gets.load(), snaps.load());
+    return (failures == 0) ? 0 : 1;
+}
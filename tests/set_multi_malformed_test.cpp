@@ -0,0 +1,100 @@
+// SetMultiReq malformado: o número de registros (FrameSlotId) vem da linha e
+// inputData aceita frames maiores que o buffer. Um frame com CRC válido e
+// mais registros do que cabem no payload (ou em MaxRecords) deve ser
+// rejeitado com errFault, sem escrever slots nem enviar ACK. Um SetMultiReq
+// válido continua sendo aplicado. Vale para CompactFrame e WideFrame.
+//
+//   g++ -std=c++17 -O1 -fsanitize=address,undefined -I.. set_multi_malformed_test.cpp -o set_multi_malformed_test && ./set_multi_malformed_test
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "SyncBus.hpp"
+
+using namespace SyncBus;
+
+static unsigned g_failures = 0;
+static unsigned g_sent = 0;
+
+static void check(const char* what, bool ok)
+{
+    if (!ok) {
+        std::printf("FALHA %s\n", what);
+        ++g_failures;
+    }
+}
+
+template<typename Format>
+static void run(const char* name)
+{
+    using length_t = typename Format::length_t;
+    using slot_t = typename Format::slot_t;
+
+    SyncBusServer<2, 0U, Format> server(7, [](const uint8_t*, length_t) { ++g_sent; });
+    uint16_t a = 0x1111U;
+    uint16_t b = 0x2222U;
+    server.addSlot(&a, 1, sizeof(a));
+    server.addSlot(&b, 2, sizeof(b));
+
+    // Registros: [slotId][len][dados]
+    auto frame = [](slot_t count, const std::vector<uint8_t>& records) {
+        std::vector<uint8_t> f(Format::HeaderSize + records.size() + 2U);
+        writeHeader<Format>(f.data(), 7, count, SyncBusFunc::SetMultiReq);
+        std::copy(records.begin(), records.end(), f.begin() + Format::HeaderSize);
+        genCRC16(f.data(), static_cast<length_t>(Format::HeaderSize + records.size()));
+        return f;
+    };
+    auto record = [](std::vector<uint8_t>& out, slot_t id, const void* data, length_t len) {
+        uint8_t head[Format::RecordHeaderSize];
+        Format::writeField(head, id);
+        Format::writeField(&head[sizeof(slot_t)], len);
+        out.insert(out.end(), head, head + Format::RecordHeaderSize);
+        out.insert(out.end(), static_cast<const uint8_t*>(data),
+                   static_cast<const uint8_t*>(data) + len);
+    };
+
+    // 1) Mais registros que MaxRecords, todos vazios (cabem no payload)
+    const size_t many = Format::BufferSize / Format::RecordHeaderSize + 8U;
+    std::vector<uint8_t> recs;
+    for (size_t r = 0; r < many; ++r) {
+        record(recs, static_cast<slot_t>(r % 2U == 0U ? 1U : 2U), nullptr, 0U);
+    }
+    std::vector<uint8_t> f = frame(static_cast<slot_t>(many), recs);
+    g_sent = 0;
+    check("contagem acima de MaxRecords",
+          (server.inputData(f.data(), static_cast<length_t>(f.size())) == result::errFault)
+          && (g_sent == 0U));
+
+    // 2) Contagem maior do que o payload comporta
+    recs.clear();
+    const uint16_t v = 0xBEEFU;
+    record(recs, 1, &v, sizeof(v));
+    f = frame(static_cast<slot_t>(100U), recs);
+    g_sent = 0;
+    check("contagem acima do payload",
+          (server.inputData(f.data(), static_cast<length_t>(f.size())) == result::errFault)
+          && (g_sent == 0U) && (a == 0x1111U));
+
+    // 3) SetMultiReq válido ainda é aplicado e confirmado
+    recs.clear();
+    const uint16_t va = 0xAAAAU;
+    const uint16_t vb = 0xBBBBU;
+    record(recs, 1, &va, sizeof(va));
+    record(recs, 2, &vb, sizeof(vb));
+    f = frame(static_cast<slot_t>(2U), recs);
+    g_sent = 0;
+    check("SetMultiReq válido",
+          (server.inputData(f.data(), static_cast<length_t>(f.size())) == result::ok)
+          && (a == 0xAAAAU) && (b == 0xBBBBU) && (g_sent == (SYNCBUS_ENABLE_SET_ACK ? 1U : 0U)));
+
+    std::printf("%s: ok\n", name);
+}
+
+int main()
+{
+    run<CompactFrame>("CompactFrame");
+    run<WideFrame>("WideFrame");
+    std::printf("SetMultiReq malformado: %u falhas\n", g_failures);
+    return (g_failures == 0) ? 0 : 1;
+}